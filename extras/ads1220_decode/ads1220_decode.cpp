@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * ads1220_decode - Decodificador de host para el streaming binario
+ *
+ * Lee tramas generadas por ADS1220_NTC_Extended::writeBinaryFrame() desde un
+ * archivo, un puerto serie ya configurado (ej. /dev/ttyUSB0) o stdin, y
+ * escribe las muestras como CSV en stdout. Las tramas de configuración
+ * (writeConfigFrame()) se resumen en stderr, igual que el estado del enlace
+ * (tramas, errores de CRC, tramas perdidas).
+ *
+ * Compilación:
+ *   g++ -O2 -I../../src ads1220_decode.cpp ../../src/ADS1220_Protocol.cpp \
+ *       ../../src/ADS1220_Config.cpp -o ads1220_decode
+ *
+ * Uso:
+ *   ads1220_decode [archivo|-] [--no-header]
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "ADS1220_Protocol.h"
+
+static void printUsage(const char* program) {
+    fprintf(stderr, "Uso: %s [archivo|-] [--no-header]\n", program);
+}
+
+static void printFrame(const ADS1220_FrameDecoder &decoder, uint32_t &samples, uint32_t &configs) {
+    if (decoder.frameType() == ADS1220_FRAME_CONFIG) {
+        ADS1220_Config config;
+        if (decoder.config(config)) {
+            fprintf(stderr, "Configuración (secuencia %u, t=%lu us): REG0..3 = %02X %02X %02X %02X\n",
+                    (unsigned)decoder.sequence(), (unsigned long)decoder.baseTimestamp(),
+                    config.registers[0], config.registers[1],
+                    config.registers[2], config.registers[3]);
+            configs++;
+        }
+        return;
+    }
+    for (uint8_t i = 0; i < decoder.recordCount(); i++) {
+        ADS1220_Sample sample;
+        if (!decoder.sample(i, sample)) {
+            continue;
+        }
+        printf("%u,%lu,%u,0x%02X,%ld,", (unsigned)decoder.sequence(),
+               (unsigned long)sample.timestamp, (unsigned)sample.channel,
+               (unsigned)sample.flags, (long)sample.raw);
+        if (sample.flags & ADS1220_SAMPLE_VALUE_VALID) {
+            printf("%.6g", sample.value);
+        }
+        float sensorTemp;
+        if (decoder.sensorTemperature(i, sensorTemp)) {
+            printf(",%.6g", sensorTemp);
+        } else {
+            printf(",");
+        }
+        printf("\n");
+        samples++;
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* path = "-";
+    bool header = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--no-header") == 0) {
+            header = false;
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    FILE* input = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+    if (input == NULL) {
+        fprintf(stderr, "No se pudo abrir %s\n", path);
+        return 1;
+    }
+
+    if (header) {
+        printf("sequence,timestamp_us,channel,flags,raw,value,sensor_temp\n");
+    }
+
+    ADS1220_FrameDecoder decoder;
+    uint32_t samples = 0;
+    uint32_t configs = 0;
+    int c;
+    while ((c = fgetc(input)) != EOF) {
+        if (decoder.push((uint8_t)c)) {
+            printFrame(decoder, samples, configs);
+        }
+    }
+    // Tramas completas que quedaron en el buffer tras una resincronización
+    while (decoder.flush()) {
+        printFrame(decoder, samples, configs);
+    }
+
+    if (input != stdin) {
+        fclose(input);
+    }
+
+    fprintf(stderr, "Tramas: %lu  Muestras: %lu  Configuraciones: %lu  Errores CRC: %lu  Tramas perdidas: %lu\n",
+            (unsigned long)decoder.framesDecoded(), (unsigned long)samples, (unsigned long)configs,
+            (unsigned long)decoder.crcErrors(), (unsigned long)decoder.framesLost());
+    return 0;
+}
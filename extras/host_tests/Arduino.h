@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Núcleo Arduino mínimo para pruebas en host
+ *
+ * Solo lo que usa la librería: tipos, constantes, tiempo (reloj monótono del
+ * host), pines sin efecto y Print/Stream. Print escribe en stdout, así que
+ * printSummary(&Serial) y compañía funcionan igual que en la placa.
+ *
+ * No define ESP32 ni __AVR__: se compila la variante genérica del driver
+ * (sin almacenamiento no volátil ni PWM por hardware).
+ ******************************************************************************/
+
+#ifndef ADS1220_HOST_ARDUINO_H
+#define ADS1220_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define FALLING 2
+#define DEC 10
+#define HEX 16
+#define PI 3.1415926535897932384626433832795
+
+#define F(x) (x)
+#define IRAM_ATTR
+
+// ===== TIEMPO =====
+unsigned long micros();
+unsigned long millis();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+inline void yield() {}
+
+// ===== PINES E INTERRUPCIONES (sin efecto) =====
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline void analogWrite(uint8_t, int) {}
+inline int digitalPinToInterrupt(int pin) { return pin; }
+inline void attachInterrupt(int, void (*)(), int) {}
+inline void detachInterrupt(int) {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+// ===== PRINT / STREAM =====
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) { return fputc(c, stdout) == EOF ? 0 : 1; }
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (n < size && write(buffer[n])) {
+            n++;
+        }
+        return n;
+    }
+
+    size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(int v, int base = DEC) { return print((long)v, base); }
+    size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = DEC) { return _format(base == HEX ? "%lX" : "%ld", v); }
+    size_t print(unsigned long v, int base = DEC) { return _format(base == HEX ? "%lX" : "%lu", v); }
+    size_t print(double v, int digits = 2) {
+        char buffer[48];
+        snprintf(buffer, sizeof(buffer), "%.*f", digits, v);
+        return print(buffer);
+    }
+
+    size_t println() { return print("\r\n"); }
+    template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+    template <typename T> size_t println(T v, int format) { size_t n = print(v, format); return n + println(); }
+
+private:
+    template <typename T> size_t _format(const char* format, T v) {
+        char buffer[24];
+        snprintf(buffer, sizeof(buffer), format, v);
+        return print(buffer);
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+
+    size_t readBytes(uint8_t* buffer, size_t length) {
+        size_t n = 0;
+        while (n < length) {
+            int c = read();
+            if (c < 0) {
+                break;
+            }
+            buffer[n++] = (uint8_t)c;
+        }
+        return n;
+    }
+};
+
+extern Stream Serial;
+
+#endif // ADS1220_HOST_ARDUINO_H
@@ -0,0 +1,33 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - SPI mínimo para pruebas en host
+ *
+ * Solo permite compilar ADS1220_SPITransport: el bus no hace nada y lee
+ * 0xFF. Las pruebas usan ADS1220_MockTransport.
+ ******************************************************************************/
+
+#ifndef ADS1220_HOST_SPI_H
+#define ADS1220_HOST_SPI_H
+
+#include "Arduino.h"
+
+#define MSBFIRST 1
+#define SPI_MODE1 1
+
+class SPISettings {
+public:
+    SPISettings() {}
+    SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass {
+public:
+    void begin() {}
+    void beginTransaction(SPISettings) {}
+    void endTransaction() {}
+    uint8_t transfer(uint8_t) { return 0xFF; }
+    void transfer(void* buffer, size_t length) { memset(buffer, 0xFF, length); }
+};
+
+extern SPIClass SPI;
+
+#endif // ADS1220_HOST_SPI_H
@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Núcleo Arduino mínimo para pruebas en host
+ ******************************************************************************/
+
+#include "Arduino.h"
+#include "SPI.h"
+#include <chrono>
+
+Stream Serial;
+SPIClass SPI;
+
+// =============================================================================
+// TIEMPO
+// =============================================================================
+
+static const std::chrono::steady_clock::time_point g_start = std::chrono::steady_clock::now();
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - g_start).count();
+}
+
+unsigned long millis() {
+    return micros() / 1000UL;
+}
+
+// Espera activa, como en la placa: las pruebas miden tiempos con micros()
+void delayMicroseconds(unsigned int us) {
+    unsigned long start = micros();
+    while (micros() - start < us) {
+    }
+}
+
+void delay(unsigned long ms) {
+    unsigned long start = micros();
+    while (micros() - start < ms * 1000UL) {
+    }
+}
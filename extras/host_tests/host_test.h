@@ -0,0 +1,64 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Utilidades de las pruebas en host
+ ******************************************************************************/
+
+#ifndef ADS1220_HOST_TEST_H
+#define ADS1220_HOST_TEST_H
+
+#include <Arduino.h>
+#include <vector>
+
+static int g_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: falla: %s\n", __FILE__, __LINE__, #cond); \
+        g_failures++; \
+    } \
+} while (0)
+
+#define CHECK_NEAR(a, b, tol) do { \
+    double _a = (a), _b = (b); \
+    if (!(fabs(_a - _b) <= (tol))) { \
+        fprintf(stderr, "%s:%d: falla: %s = %g, %s = %g (tolerancia %g)\n", \
+                __FILE__, __LINE__, #a, _a, #b, _b, (double)(tol)); \
+        g_failures++; \
+    } \
+} while (0)
+
+/**
+ * @brief Código de salida de main(): 0 si no falló ningún CHECK
+ */
+static inline int testResult(const char* name) {
+    printf("%s: %s\r\n", name, g_failures == 0 ? "OK" : "FALLÓ");
+    return g_failures == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Stream en memoria: lo escrito se puede volver a leer (grabaciones)
+ */
+class HostBuffer : public Stream {
+public:
+    std::vector<uint8_t> data;
+    size_t position = 0;
+
+    size_t write(uint8_t c) override { data.push_back(c); return 1; }
+    size_t write(const uint8_t* buffer, size_t size) override {
+        data.insert(data.end(), buffer, buffer + size);
+        return size;
+    }
+    int available() override { return (int)(data.size() - position); }
+    int read() override { return position < data.size() ? data[position++] : -1; }
+    int peek() override { return position < data.size() ? data[position] : -1; }
+};
+
+/**
+ * @brief Stream que descarta la salida (tablas y resúmenes que no se verifican)
+ */
+class NullStream : public Stream {
+public:
+    size_t write(uint8_t) override { return 1; }
+    size_t write(const uint8_t*, size_t size) override { return size; }
+};
+
+#endif // ADS1220_HOST_TEST_H
@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Prueba de host: diagnóstico de sensores
+ *
+ * Una NTC sana por encima del techo de la conversión de diagnóstico (10 µA)
+ * satura el BCS sin saturar la IDAC: debe quedar fuera de rango, no abierta.
+ ******************************************************************************/
+
+#include "host_test.h"
+#include "ADS1220_NTC_Extended.h"
+#include "ADS1220_MockTransport.h"
+
+#define HIGH_R_CODE     5000000     // NTC de alta resistencia con IDAC, sin saturar
+
+struct Sensor {
+    int32_t idacCode;               // Código con IDAC (BCS apagado)
+};
+
+// Con BCS encendido (bit 0 de REG1) la conversión satura siempre
+static int32_t highResistanceNtc(const uint8_t* registers, void* context) {
+    if (registers[1] & 0x01) {
+        return ADS1220_MAX_CODE;
+    }
+    return ((Sensor*)context)->idacCode;
+}
+
+static ADS1220_ReadStatus readBlocking(ADS1220_NTC_Extended &adc, ADS1220_Sample &sample) {
+    if (!adc.startRead(CHANNEL_0)) {
+        return READ_IDLE;
+    }
+    ADS1220_ReadStatus status;
+    while ((status = adc.poll(sample)) == READ_PENDING) {
+    }
+    return status;
+}
+
+int main() {
+    Sensor sensor = { HIGH_R_CODE };
+    ADS1220_MockTransport mock;
+    mock.setConverter(highResistanceNtc, &sensor);
+    ADS1220_NTC_Extended adc(5, 255);
+    CHECK(adc.begin(&mock));
+    adc.setSettlingTime(0);
+    adc.setReferenceResistor(CHANNEL_0, 470000.0f);
+
+    const float resistance = adc.readResistance(CHANNEL_0);
+    CHECK(resistance > 250000.0f);
+    adc.setSensorDiagnostics(1);
+
+    // ===== BCS saturado, IDAC válida: fuera de rango =====
+    ADS1220_Sample sample;
+    CHECK(readBlocking(adc, sample) == READ_READY);
+    CHECK(adc.getChannelHealth(CHANNEL_0) == HEALTH_OUT_OF_RANGE);
+    CHECK(sample.flags & ADS1220_SAMPLE_SENSOR_FAULT);
+
+    // ===== Resistencia IDAC por encima de maxOhms: abierta =====
+    adc.setSensorResistanceRange(CHANNEL_0, ADS1220_DIAG_SHORT_OHMS, resistance * 0.5f);
+    CHECK(readBlocking(adc, sample) == READ_READY);
+    CHECK(adc.getChannelHealth(CHANNEL_0) == HEALTH_OPEN);
+
+    // Por debajo de maxOhms vuelve a fuera de rango
+    adc.setSensorResistanceRange(CHANNEL_0, ADS1220_DIAG_SHORT_OHMS, resistance * 2.0f);
+    CHECK(readBlocking(adc, sample) == READ_READY);
+    CHECK(adc.getChannelHealth(CHANNEL_0) == HEALTH_OUT_OF_RANGE);
+
+    // ===== IDAC también saturada: abierta =====
+    sensor.idacCode = ADS1220_MAX_CODE;
+    CHECK(readBlocking(adc, sample) == READ_READY);
+    CHECK(adc.getChannelHealth(CHANNEL_0) == HEALTH_OPEN);
+    CHECK(!(sample.flags & ADS1220_SAMPLE_VALUE_VALID));
+
+    // ===== Con el compensador activo la lectura saturada no devuelve el filtro =====
+    adc.setResponseCompensation(CHANNEL_0, 1.0f);
+    sensor.idacCode = HIGH_R_CODE;
+    float filtered = adc.readTemperatureFiltered(CHANNEL_0);
+    CHECK(filtered != -999.0f);
+    sensor.idacCode = ADS1220_MAX_CODE;
+    CHECK(adc.readTemperatureFiltered(CHANNEL_0) == -999.0f);
+
+    return testResult("test_diagnostics");
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Prueba de host: modelo directo código -> °C
+ *
+ * El modelo por tramos debe reproducir la cadena completa
+ * (code -> V -> R -> Steinhart-Hart) en -40..125 °C con error < 1 mK, en
+ * varias combinaciones de IDAC, ganancia y referencia. Se comprueba con
+ * verifyDirectModel() y leyendo los mismos códigos del mock con el modelo
+ * activado y desactivado.
+ ******************************************************************************/
+
+#include "host_test.h"
+#include "ADS1220_NTC_Extended.h"
+#include "ADS1220_MockTransport.h"
+
+#define MODEL_TOLERANCE     0.001f  // °C
+
+struct ModelCase {
+    float idac_uA;
+    uint8_t gain;
+    float referenceResistor;        // 0 = referencia interna
+};
+
+static void checkCase(const ModelCase &c) {
+    ADS1220_MockTransport mock;
+    ADS1220_NTC_Extended adc(5, 255, c.idac_uA);
+    CHECK(adc.begin(&mock));
+    adc.setGain(c.gain);
+    if (c.referenceResistor > 0.0f) {
+        adc.setReferenceResistor(CHANNEL_0, c.referenceResistor);
+    }
+
+    CHECK(adc.verifyDirectModel(CHANNEL_0) < 0.0f);    // Aún deshabilitado
+    adc.setDirectTemperatureModel(CHANNEL_0, true, -40.0f, 125.0f);
+    float maxError = adc.verifyDirectModel(CHANNEL_0, 2000);
+    CHECK(maxError >= 0.0f);
+    CHECK(maxError < MODEL_TOLERANCE);
+
+    // Mismos códigos por readTemperature() con y sin modelo
+    uint16_t inRange = 0;
+    float worst = 0.0f;
+    for (int32_t code = 1000; code < ADS1220_SATURATION_CODE; code = code * 9 / 8) {
+        mock.setConversionCode(code);
+        adc.setDirectTemperatureModel(CHANNEL_0, false);
+        float chain = adc.readTemperature(CHANNEL_0);
+        if (isnan(chain) || chain < -40.0f || chain > 125.0f) {
+            continue;
+        }
+        adc.setDirectTemperatureModel(CHANNEL_0, true, -40.0f, 125.0f);
+        float model = adc.readTemperature(CHANNEL_0);
+        worst = fmaxf(worst, fabsf(model - chain));
+        inRange++;
+    }
+    adc.setDirectTemperatureModel(CHANNEL_0, false);
+    CHECK(inRange >= 10);
+    CHECK(worst < MODEL_TOLERANCE);
+    printf("IDAC %.0f µA, ganancia %d, Rref %.0f Ω: verify %.3g °C, lectura %.3g °C (%u códigos)\r\n",
+           c.idac_uA, 1 << (c.gain >> 1), c.referenceResistor, maxError, worst, inRange);
+}
+
+int main() {
+    static const ModelCase cases[] = {
+        {100.0f, ADS1220_GAIN_1, 0.0f},
+        {50.0f, ADS1220_GAIN_1, 0.0f},
+        {100.0f, ADS1220_GAIN_4, 0.0f},
+        {100.0f, ADS1220_GAIN_1, 20000.0f},
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        checkCase(cases[i]);
+    }
+    return testResult("test_direct_model");
+}
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Prueba de host: driver sobre el mock
+ *
+ * Lectura completa con startRead()/poll() y contenido de los registros en
+ * cada fase del chopper: el convertidor anota REG0 y REG3 de cada conversión.
+ ******************************************************************************/
+
+#include "host_test.h"
+#include "ADS1220_NTC_Extended.h"
+#include "ADS1220_MockTransport.h"
+
+#define SIGNAL_CH0      400000      // Código de la NTC en CHANNEL_0
+#define SIGNAL_CH1      250000      // Código de la NTC en CHANNEL_1
+#define INPUT_OFFSET    123         // Offset de entrada del ADC
+
+struct Conversion {
+    uint8_t reg0;
+    uint8_t reg3;
+};
+
+// +V + Vos con el MUX directo, -V + Vos invertido, Vos en corto
+static int32_t ntcWithOffset(const uint8_t* registers, void* context) {
+    ((std::vector<Conversion>*)context)->push_back(Conversion{registers[0], registers[3]});
+    switch (registers[0] & 0xF0) {
+        case ADS1220_MUX_AIN0_AIN1: return SIGNAL_CH0 + INPUT_OFFSET;
+        case ADS1220_MUX_AIN1_AIN0: return -SIGNAL_CH0 + INPUT_OFFSET;
+        case ADS1220_MUX_AIN2_AIN3: return SIGNAL_CH1 + INPUT_OFFSET;
+        case ADS1220_MUX_AIN3_AIN2: return -SIGNAL_CH1 + INPUT_OFFSET;
+        default: return INPUT_OFFSET;
+    }
+}
+
+static ADS1220_ReadStatus readBlocking(ADS1220_NTC_Extended &adc, ADS1220_Channel channel,
+                                       ADS1220_Sample &sample) {
+    if (!adc.startRead(channel)) {
+        return READ_IDLE;
+    }
+    ADS1220_ReadStatus status;
+    while ((status = adc.poll(sample)) == READ_PENDING) {
+    }
+    return status;
+}
+
+// Registros del chip iguales a la imagen del driver
+static bool chipMatchesDriver(ADS1220_MockTransport &mock, ADS1220_NTC_Extended &adc) {
+    ADS1220_Config config;
+    adc.exportConfiguration(config);
+    for (uint8_t i = 0; i < 4; i++) {
+        if (mock.getRegister(i) != config.registers[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::vector<Conversion> conversions;
+    ADS1220_MockTransport mock;
+    mock.setConverter(ntcWithOffset, &conversions);
+    ADS1220_NTC_Extended adc(5, 255);
+    CHECK(adc.begin(&mock));
+    adc.setSettlingTime(0);
+
+    const uint8_t normalReg3 = (ADS1220_IDAC_AIN0 << 5) | (ADS1220_IDAC_AIN2 << 2);
+    const uint8_t swappedReg3 = (ADS1220_IDAC_AIN2 << 5) | (ADS1220_IDAC_AIN0 << 2);
+    CHECK(mock.getRegister(ADS1220_REG3) == normalReg3);
+
+    // ===== startRead()/poll() sin chopper =====
+    ADS1220_Sample sample;
+    conversions.clear();
+    CHECK(readBlocking(adc, CHANNEL_1, sample) == READ_READY);
+    CHECK(sample.channel == CHANNEL_1);
+    CHECK(sample.raw == SIGNAL_CH1 + INPUT_OFFSET);
+    CHECK(sample.flags & ADS1220_SAMPLE_VALUE_VALID);
+    CHECK(!(sample.flags & ADS1220_SAMPLE_CHOPPED));
+    CHECK(conversions.size() == 1);
+    CHECK((conversions[0].reg0 & 0xF0) == ADS1220_MUX_AIN2_AIN3);
+    CHECK(chipMatchesDriver(mock, adc));
+
+    // Con offset calibrado la lectura lo descuenta; la primera conversión en corto se descarta
+    conversions.clear();
+    CHECK(adc.calibrateOffset(4));
+    CHECK(conversions.size() == 5);
+    CHECK((conversions[0].reg0 & 0xF0) == ADS1220_MUX_SHORTED);
+    CHECK(adc.getOffset(mock.getRegister(ADS1220_REG0) & 0x0E) == INPUT_OFFSET);
+    CHECK(readBlocking(adc, CHANNEL_1, sample) == READ_READY);
+    CHECK(sample.raw == SIGNAL_CH1);
+    CHECK(sample.flags & ADS1220_SAMPLE_OFFSET_CORRECTED);
+
+    // ===== Chopper: fase A normal, fase B con MUX invertido e IDAC intercambiados =====
+    adc.setChopMode(CHANNEL_0, true);
+    conversions.clear();
+    CHECK(readBlocking(adc, CHANNEL_0, sample) == READ_READY);
+    CHECK(conversions.size() == 2);
+    if (conversions.size() == 2) {
+        CHECK((conversions[0].reg0 & 0xF0) == ADS1220_MUX_AIN0_AIN1);
+        CHECK(conversions[0].reg3 == normalReg3);
+        CHECK((conversions[1].reg0 & 0xF0) == ADS1220_MUX_AIN1_AIN0);
+        CHECK(conversions[1].reg3 == swappedReg3);
+    }
+    CHECK(sample.raw == SIGNAL_CH0);                // (A - B) / 2 cancela el offset
+    CHECK(sample.flags & ADS1220_SAMPLE_CHOPPED);
+    CHECK(mock.getRegister(ADS1220_REG3) == normalReg3);
+
+    // El otro canal lee con el enrutamiento normal
+    conversions.clear();
+    CHECK(readBlocking(adc, CHANNEL_1, sample) == READ_READY);
+    CHECK(conversions.size() == 1 && conversions[0].reg3 == normalReg3);
+    CHECK(sample.raw == SIGNAL_CH1);
+
+    // ===== cancelRead() en la fase B restaura REG3 =====
+    CHECK(adc.startRead(CHANNEL_0));
+    for (int i = 0; i < 100 && mock.getRegister(ADS1220_REG3) != swappedReg3; i++) {
+        CHECK(adc.poll(sample) == READ_PENDING);
+    }
+    CHECK(mock.getRegister(ADS1220_REG3) == swappedReg3);
+    adc.cancelRead();
+    CHECK(!adc.isReadBusy());
+    CHECK(mock.getRegister(ADS1220_REG3) == normalReg3);
+    CHECK(chipMatchesDriver(mock, adc));
+
+    // ===== setStatisticsInterval(0) detiene los bloques =====
+    ADS1220_Statistics stats;
+    adc.setStatisticsInterval(CHANNEL_1, 1000);
+    CHECK(adc.getStatistics(CHANNEL_1, stats));
+    adc.setStatisticsInterval(CHANNEL_1, 0);
+    CHECK(!adc.getStatistics(CHANNEL_1, stats));
+    CHECK(readBlocking(adc, CHANNEL_1, sample) == READ_READY);
+    CHECK(!adc.readStatisticsBlock(CHANNEL_1, stats));
+
+    return testResult("test_mock_transport");
+}
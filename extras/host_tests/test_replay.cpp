@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Prueba de host: grabación y reproducción
+ *
+ * Graba con writeConfigFrame()/writeBinaryFrame() en memoria, reproduce en un
+ * driver nuevo con ADS1220_Replay y exige el mismo resultado bit a bit:
+ * valores, banderas, estadísticas y eventos. El driver de reproducción
+ * empieza con otra configuración; la trama de configuración la corrige.
+ * Una cabecera corrupta no hace perder las tramas que siguen.
+ ******************************************************************************/
+
+#include "host_test.h"
+#include "ADS1220_NTC_Extended.h"
+#include "ADS1220_MockTransport.h"
+#include "ADS1220_Replay.h"
+
+static uint32_t g_conversion = 0;
+
+// NTC en CHANNEL_0 con ruido y escalones; CHANNEL_1 negativo (canal B del chopper)
+static int32_t recordedSignal(const uint8_t* registers, void* context) {
+    (void)context;
+    g_conversion++;
+    int32_t base = ((registers[0] >> 4) == 0x0) ? 409600 : -300000;
+    return base + (int32_t)(300.0 * sin(g_conversion * 0.37)) + (int32_t)(g_conversion % 7) * 11
+           + ((g_conversion / 500) % 2) * 4000;
+}
+
+static void configure(ADS1220_NTC_Extended &adc) {
+    adc.setSettlingTime(0);
+    adc.enableStatistics(CHANNEL_0);
+    adc.enableStatistics(CHANNEL_1);
+    adc.setEventReporting(CHANNEL_0, 0.02f, 0.0f, 50);
+}
+
+static void collectEvent(const ADS1220_Sample &event, void* context) {
+    ((std::vector<ADS1220_Sample>*)context)->push_back(event);
+}
+
+static bool sameSamples(const std::vector<ADS1220_Sample> &a, const std::vector<ADS1220_Sample> &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].timestamp != b[i].timestamp || a[i].flags != b[i].flags ||
+            memcmp(&a[i].value, &b[i].value, sizeof(float)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// NTC con chopper, offset periódico, promedio, estadísticas y eventos
+static void testTemperatureRoundTrip() {
+    HostBuffer recording;
+    std::vector<ADS1220_Sample> liveEvents;
+    std::vector<ADS1220_Sample> replayEvents;
+
+    ADS1220_MockTransport mock;
+    mock.setConverter(recordedSignal);
+    ADS1220_NTC_Extended live(5, 255);
+    CHECK(live.begin(&mock));
+    configure(live);
+    live.setMovingAverageSize(8);
+    live.setChopMode(CHANNEL_1, true);
+    live.setOffsetRefreshInterval(10);
+    live.setEventCallback(collectEvent, &liveEvents);
+    CHECK(live.writeConfigFrame(&recording));
+
+    ADS1220_Sample sample;
+    for (int i = 0; i < 3000; i++) {
+        delayMicroseconds(20);
+        CHECK(live.startRead((i % 3) ? CHANNEL_0 : CHANNEL_1));
+        while (live.poll(sample) == READ_PENDING) {
+        }
+        if (live.availableSamples() >= 16) {
+            live.writeBinaryFrame(&recording, true);
+        }
+    }
+    while (live.writeBinaryFrame(&recording, true)) {
+    }
+
+    ADS1220_MockTransport replayMock;
+    ADS1220_NTC_Extended replayed(5, 255);
+    CHECK(replayed.begin(&replayMock));
+    configure(replayed);
+    replayed.setMovingAverageSize(2);               // Lo corrige la trama de configuración
+    replayed.setEventCallback(collectEvent, &replayEvents);
+
+    ADS1220_Replay replay(replayed);
+    CHECK(replay.run(&recording) == 3000);
+    CHECK(replay.getConfigs() == 1);
+    CHECK(replay.getRejected() == 0);
+    CHECK(replay.getCompared() == 3000);
+    CHECK(replay.getMismatches() == 0);
+    CHECK(replay.decoder().crcErrors() == 0);
+    CHECK(replayMock.conversionCount() == 0);       // Ninguna conversión real
+
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        ADS1220_Statistics liveStats;
+        ADS1220_Statistics replayStats;
+        CHECK(live.getStatistics((ADS1220_Channel)ch, liveStats));
+        CHECK(replayed.getStatistics((ADS1220_Channel)ch, replayStats));
+        CHECK(memcmp(&liveStats, &replayStats, sizeof(liveStats)) == 0);
+    }
+    CHECK(!liveEvents.empty());
+    CHECK(sameSamples(liveEvents, replayEvents));
+}
+
+// Flujo térmico con temperatura de sensor distinta en cada lectura y NTC con modelo directo
+static void testHeatFluxRoundTrip() {
+    HostBuffer recording;
+    ADS1220_MockTransport mock;
+    ADS1220_NTC_Extended live(5, 255, 0.0f);
+    CHECK(live.begin(&mock));
+    live.setSettlingTime(0);
+    live.setChannelMode(CHANNEL_0, MODE_HEAT_FLUX);
+    live.setDirectTemperatureModel(CHANNEL_1, true, -40.0f, 125.0f);
+    CHECK(live.writeConfigFrame(&recording));
+
+    for (int i = 0; i < 8; i++) {
+        mock.setConversionCode(1000 + i * 37);
+        live.readHeatFlux(CHANNEL_0, 30.0f + i);
+    }
+    for (int i = 0; i < 8; i++) {
+        mock.setConversionCode(300000 + i * 5000);
+        live.readTemperature(CHANNEL_1);
+    }
+    while (live.writeBinaryFrame(&recording, true)) {
+    }
+
+    ADS1220_MockTransport replayMock;
+    ADS1220_NTC_Extended replayed(5, 255, 0.0f);
+    CHECK(replayed.begin(&replayMock));
+    ADS1220_Replay replay(replayed);
+    CHECK(replay.run(&recording) == 16);
+    CHECK(replay.getCompared() == 16);
+    CHECK(replay.getMismatches() == 0);
+}
+
+// Sin la trama de configuración y con otra resistencia de referencia, la comparación lo detecta
+static void testMismatchDetected() {
+    HostBuffer recording;
+    ADS1220_MockTransport mock;
+    mock.setConverter(recordedSignal);
+    ADS1220_NTC_Extended live(5, 255);
+    CHECK(live.begin(&mock));
+    live.setSettlingTime(0);
+    for (int i = 0; i < 16; i++) {
+        live.readTemperature(CHANNEL_0);
+    }
+    CHECK(live.writeBinaryFrame(&recording, true));
+
+    ADS1220_MockTransport replayMock;
+    ADS1220_NTC_Extended replayed(5, 255);
+    CHECK(replayed.begin(&replayMock));
+    replayed.setReferenceResistor(CHANNEL_0, 10500.0f);
+    ADS1220_Replay replay(replayed);
+    CHECK(replay.run(&recording) == 16);
+    CHECK(replay.getCompared() == 16);
+    CHECK(replay.getMismatches() == 16);
+}
+
+// Cabecera corrupta que alarga la primera trama más allá del final: las
+// siguientes, ya completas en el buffer, se recuperan en EOF
+static void testCorruptHeaderTail() {
+    HostBuffer recording;
+    ADS1220_MockTransport mock;
+    mock.setConverter(recordedSignal);
+    ADS1220_NTC_Extended live(5, 255);
+    CHECK(live.begin(&mock));
+    live.setSettlingTime(0);
+    for (int frame = 0; frame < 4; frame++) {
+        for (int i = 0; i < 4; i++) {
+            live.readTemperature(CHANNEL_0);
+        }
+        CHECK(live.writeBinaryFrame(&recording, true));
+    }
+    recording.data[5] = ADS1220_FRAME_MAX_RECORDS;  // Número de registros de la primera trama
+
+    ADS1220_MockTransport replayMock;
+    ADS1220_NTC_Extended replayed(5, 255);
+    CHECK(replayed.begin(&replayMock));
+    ADS1220_Replay replay(replayed);
+    CHECK(replay.run(&recording) == 12);
+    CHECK(replay.decoder().framesDecoded() == 3);
+    CHECK(replay.getMismatches() == 0);
+}
+
+int main() {
+    testTemperatureRoundTrip();
+    testHeatFluxRoundTrip();
+    testMismatchDetected();
+    testCorruptHeaderTail();
+    return testResult("test_replay");
+}
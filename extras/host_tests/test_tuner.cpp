@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Prueba de host: ADS1220_Tuner sobre el mock
+ *
+ * El convertidor emula una NTC de 10 kΩ excitada con 10 µA (0.1 V) con ruido
+ * blanco que crece con el data rate y una deriva lenta. Las ganancias que
+ * llevan 0.1 V por encima del fondo de escala saturan.
+ ******************************************************************************/
+
+#include "host_test.h"
+#include "ADS1220_NTC_Extended.h"
+#include "ADS1220_MockTransport.h"
+#include "ADS1220_Tuner.h"
+
+// Generador determinista: la prueba da siempre el mismo resultado
+static uint32_t g_seed = 1;
+
+static float gaussian() {
+    float sum = 0.0f;
+    for (int i = 0; i < 12; i++) {
+        g_seed = g_seed * 1664525UL + 1013904223UL;
+        sum += (float)(g_seed >> 8) / 16777216.0f;
+    }
+    return sum - 6.0f;
+}
+
+static float g_drift_uV = 0.0f;
+
+static int32_t noisyNtc(const uint8_t* registers, void* context) {
+    (void)context;
+    static const float noise_uV[7] = {0.5f, 0.7f, 1.0f, 1.6f, 2.4f, 3.5f, 5.0f};
+    uint8_t dataRate = (registers[1] >> 5) & 0x07;
+    float gain = (float)(1 << ((registers[0] >> 1) & 0x07));
+
+    g_drift_uV = 0.99f * g_drift_uV + 0.02f * gaussian();
+    float vin = 0.1f + (noise_uV[dataRate] * gaussian() + g_drift_uV) * 1e-6f;
+    double code = (double)vin * gain / 2.048 * 8388608.0;
+    if (code > 8388607.0) {
+        code = 8388607.0;
+    }
+    return (int32_t)code;
+}
+
+int main() {
+    ADS1220_MockTransport mock;
+    mock.setConverter(noisyNtc);
+    ADS1220_NTC_Extended adc(5, 255);
+    CHECK(adc.begin(&mock));
+    adc.setSettlingTime(0);
+    adc.setMovingAverageSize(3);
+
+    ADS1220_Tuner tuner(adc);
+    tuner.setSweep(0x7F, 0x3F, true);   // 7 data rates, ganancias 1..32
+    tuner.setSampleCount(64);
+
+    // Ganancia 32: 0.1 V × 32 supera 2.048 V
+    ADS1220_TuneResult saturated;
+    CHECK(!tuner.measure(CHANNEL_0, ADS1220_DR_20SPS, ADS1220_GAIN_32, false, saturated));
+    CHECK(!saturated.valid);
+
+    ADS1220_TuneResult low;
+    CHECK(tuner.measure(CHANNEL_0, ADS1220_DR_20SPS, ADS1220_GAIN_16, false, low));
+    ADS1220_TuneResult high;
+    CHECK(tuner.measure(CHANNEL_0, ADS1220_DR_1000SPS, ADS1220_GAIN_16, false, high));
+    CHECK(low.rms_uV < high.rms_uV);
+    CHECK(low.enob > high.enob);
+
+    // measure() deja aplicada su combinación; run() restaura la previa
+    ADS1220_Config before;
+    adc.exportConfiguration(before);
+
+    // Barrido completo: recomendación que cumple y configuración restaurada
+    const float target = 0.0004f;
+    NullStream table;
+    ADS1220_TuneResult best;
+    CHECK(tuner.run(CHANNEL_0, target, best, &table, false));
+    CHECK(best.valid);
+    CHECK(best.noise <= target);
+    CHECK(best.gain != ADS1220_GAIN_32);
+    CHECK(best.latency_ms >= 0.0f);
+
+    ADS1220_Config after;
+    adc.exportConfiguration(after);
+    CHECK(memcmp(after.registers, before.registers, sizeof(before.registers)) == 0);
+    CHECK(after.avgSize == before.avgSize);
+
+    // Objetivo imposible: se devuelve la de menor ruido
+    ADS1220_TuneResult quietest;
+    CHECK(!tuner.run(CHANNEL_0, 1e-9f, quietest, nullptr, false));
+    CHECK(quietest.valid);
+    CHECK(quietest.noise > 1e-9f);
+
+    // Con applyBest la recomendación queda aplicada
+    CHECK(tuner.run(CHANNEL_0, target, best, nullptr, true));
+    adc.exportConfiguration(after);
+    CHECK((after.registers[1] & 0xE0) == best.dataRate);
+    CHECK((after.registers[0] & 0x0E) == best.gain);
+    CHECK(after.avgSize == best.avgSize);
+
+    return testResult("test_tuner");
+}
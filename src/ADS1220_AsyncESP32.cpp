@@ -0,0 +1,278 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Adquisición en tarea dedicada (ESP32)
+ *
+ * Implementación de la tarea FreeRTOS, la cola de muestras y la cola de
+ * comandos de configuración.
+ ******************************************************************************/
+
+#include "ADS1220_AsyncESP32.h"
+
+#if defined(ESP32)
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+ADS1220_AsyncESP32::ADS1220_AsyncESP32(ADS1220_NTC_Extended &adc) : _adc(adc) {
+    _task = nullptr;
+    _sampleQueue = nullptr;
+    _commandQueue = nullptr;
+    _running = false;
+    _dropped = 0;
+    _channelMask = 0x03;
+    _nextChannel = 0;
+}
+
+ADS1220_AsyncESP32::~ADS1220_AsyncESP32() {
+    end();
+}
+
+// =============================================================================
+// CONTROL DE LA TAREA
+// =============================================================================
+
+bool ADS1220_AsyncESP32::begin(uint8_t channelMask, BaseType_t core,
+                               UBaseType_t priority, uint16_t queueLength) {
+    if (_running) {
+        return false;
+    }
+
+    _channelMask = channelMask & 0x03;
+    _nextChannel = 0;
+    _dropped = 0;
+
+    if (_sampleQueue == nullptr) {
+        _sampleQueue = xQueueCreate(queueLength, sizeof(ADS1220_Sample));
+    }
+    if (_commandQueue == nullptr) {
+        _commandQueue = xQueueCreate(ADS1220_ASYNC_COMMAND_LENGTH, sizeof(Command));
+    }
+    if (_sampleQueue == nullptr || _commandQueue == nullptr) {
+        return false;
+    }
+
+    _running = true;
+    if (xTaskCreatePinnedToCore(_taskEntry, "ads1220", ADS1220_ASYNC_STACK_SIZE,
+                                this, priority, &_task, core) != pdPASS) {
+        _running = false;
+        _task = nullptr;
+        return false;
+    }
+
+    // DRDY despierta a la tarea en cuanto hay un dato listo
+    uint8_t drdyPin = _adc.getDataReadyPin();
+    if (drdyPin != 255) {
+        attachInterruptArg(digitalPinToInterrupt(drdyPin), _drdyISR, this, FALLING);
+    }
+    return true;
+}
+
+void ADS1220_AsyncESP32::end() {
+    if (!_running) {
+        return;
+    }
+
+    uint8_t drdyPin = _adc.getDataReadyPin();
+    if (drdyPin != 255) {
+        detachInterrupt(digitalPinToInterrupt(drdyPin));
+    }
+
+    // La tarea termina por sí misma al procesar CMD_STOP
+    Command command = {CMD_STOP, 0, 0, 0.0f};
+    xQueueSendToFront(_commandQueue, &command, portMAX_DELAY);
+    xTaskNotifyGive(_task);
+    while (_running) {
+        vTaskDelay(1);
+    }
+    _task = nullptr;
+}
+
+bool ADS1220_AsyncESP32::receive(ADS1220_Sample &sample, TickType_t wait) {
+    if (_sampleQueue == nullptr) {
+        return false;
+    }
+    return xQueueReceive(_sampleQueue, &sample, wait) == pdTRUE;
+}
+
+uint16_t ADS1220_AsyncESP32::available() {
+    if (_sampleQueue == nullptr) {
+        return 0;
+    }
+    return (uint16_t)uxQueueMessagesWaiting(_sampleQueue);
+}
+
+uint32_t ADS1220_AsyncESP32::droppedSamples() {
+    return _dropped;
+}
+
+// =============================================================================
+// CONFIGURACIÓN SEGURA ENTRE TAREAS
+// =============================================================================
+
+bool ADS1220_AsyncESP32::setScanChannels(uint8_t channelMask) {
+    return _sendCommand(CMD_SCAN_CHANNELS, 0, channelMask, 0.0f);
+}
+
+bool ADS1220_AsyncESP32::setGain(uint8_t gain) {
+    return _sendCommand(CMD_GAIN, 0, gain, 0.0f);
+}
+
+bool ADS1220_AsyncESP32::setPGABypass(bool bypass) {
+    return _sendCommand(CMD_PGA_BYPASS, 0, bypass ? 1 : 0, 0.0f);
+}
+
+bool ADS1220_AsyncESP32::setDataRate(uint8_t dataRate) {
+    return _sendCommand(CMD_DATA_RATE, 0, dataRate, 0.0f);
+}
+
+bool ADS1220_AsyncESP32::setChannelMode(ADS1220_Channel channel, ADS1220_SensorMode mode) {
+    return _sendCommand(CMD_CHANNEL_MODE, channel, mode, 0.0f);
+}
+
+bool ADS1220_AsyncESP32::setIDACCurrent(float idacCurrent_uA) {
+    return _sendCommand(CMD_IDAC_CURRENT, 0, 0, idacCurrent_uA);
+}
+
+bool ADS1220_AsyncESP32::setChopMode(ADS1220_Channel channel, bool enable) {
+    return _sendCommand(CMD_CHOP_MODE, channel, enable ? 1 : 0, 0.0f);
+}
+
+bool ADS1220_AsyncESP32::setReferenceResistor(ADS1220_Channel channel, float referenceResistance) {
+    return _sendCommand(CMD_REFERENCE_RESISTOR, channel, 0, referenceResistance);
+}
+
+bool ADS1220_AsyncESP32::setSettlingTime(uint32_t settleTime_us) {
+    return _sendCommand(CMD_SETTLING_TIME, 0, settleTime_us, 0.0f);
+}
+
+bool ADS1220_AsyncESP32::setHeatFluxSensorTemperature(ADS1220_Channel channel, float sensorTemp) {
+    return _sendCommand(CMD_SENSOR_TEMPERATURE, channel, 0, sensorTemp);
+}
+
+bool ADS1220_AsyncESP32::calibrateOffset(uint8_t samples) {
+    return _sendCommand(CMD_CALIBRATE_OFFSET, 0, samples, 0.0f);
+}
+
+// =============================================================================
+// FUNCIONES PRIVADAS
+// =============================================================================
+
+bool ADS1220_AsyncESP32::_sendCommand(CommandType type, uint8_t channel, uint32_t u, float f) {
+    if (_commandQueue == nullptr) {
+        return false;
+    }
+    Command command = {type, channel, u, f};
+    if (xQueueSend(_commandQueue, &command, 0) != pdTRUE) {
+        return false;
+    }
+    if (_task != nullptr) {
+        xTaskNotifyGive(_task);
+    }
+    return true;
+}
+
+void ADS1220_AsyncESP32::_applyCommand(const Command &command) {
+    ADS1220_Channel channel = (command.channel == 0) ? CHANNEL_0 : CHANNEL_1;
+
+    switch (command.type) {
+        case CMD_SCAN_CHANNELS:
+            _channelMask = (uint8_t)(command.u & 0x03);
+            break;
+        case CMD_GAIN:
+            _adc.setGain((uint8_t)command.u);
+            break;
+        case CMD_PGA_BYPASS:
+            _adc.setPGABypass(command.u != 0);
+            break;
+        case CMD_DATA_RATE:
+            _adc.setDataRate((uint8_t)command.u);
+            break;
+        case CMD_CHANNEL_MODE:
+            _adc.setChannelMode(channel, (command.u == MODE_NTC) ? MODE_NTC : MODE_HEAT_FLUX);
+            break;
+        case CMD_IDAC_CURRENT:
+            _adc.setIDACCurrent(command.f);
+            break;
+        case CMD_CHOP_MODE:
+            _adc.setChopMode(channel, command.u != 0);
+            break;
+        case CMD_REFERENCE_RESISTOR:
+            _adc.setReferenceResistor(channel, command.f);
+            break;
+        case CMD_SETTLING_TIME:
+            _adc.setSettlingTime(command.u);
+            break;
+        case CMD_SENSOR_TEMPERATURE:
+            _adc.setHeatFluxSensorTemperature(channel, command.f);
+            break;
+        case CMD_CALIBRATE_OFFSET:
+            _adc.calibrateOffset((uint8_t)command.u);
+            break;
+        case CMD_STOP:
+        default:
+            break;
+    }
+}
+
+void ADS1220_AsyncESP32::_run() {
+    bool hasDrdy = (_adc.getDataReadyPin() != 255);
+
+    while (true) {
+        // Aplicar configuración solo entre conversiones
+        if (!_adc.isReadBusy()) {
+            Command command;
+            while (xQueueReceive(_commandQueue, &command, 0) == pdTRUE) {
+                if (command.type == CMD_STOP) {
+                    _running = false;
+                    vTaskDelete(nullptr);
+                    return;
+                }
+                _applyCommand(command);
+            }
+
+            if (_channelMask == 0) {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                continue;
+            }
+
+            // Siguiente canal habilitado del barrido
+            while ((_channelMask & (1 << _nextChannel)) == 0) {
+                _nextChannel = (_nextChannel + 1) & 0x01;
+            }
+            _adc.startRead(_nextChannel == 0 ? CHANNEL_0 : CHANNEL_1);
+            _nextChannel = (_nextChannel + 1) & 0x01;
+        }
+
+        ADS1220_Sample sample;
+        ADS1220_ReadStatus status = _adc.poll(sample);
+        if (status == READ_READY) {
+            if (xQueueSend(_sampleQueue, &sample, 0) != pdTRUE) {
+                _dropped++;
+            }
+            // El buffer interno del driver no se consume en este modo
+            ADS1220_Sample discarded;
+            while (_adc.readSample(discarded)) {
+            }
+        } else if (status == READ_PENDING) {
+            // Dormir hasta DRDY (o un comando); sin DRDY, un tick
+            ulTaskNotifyTake(pdTRUE, hasDrdy ? pdMS_TO_TICKS(2) : 1);
+        }
+    }
+}
+
+void ADS1220_AsyncESP32::_taskEntry(void* arg) {
+    static_cast<ADS1220_AsyncESP32*>(arg)->_run();
+}
+
+void IRAM_ATTR ADS1220_AsyncESP32::_drdyISR(void* arg) {
+    ADS1220_AsyncESP32* self = static_cast<ADS1220_AsyncESP32*>(arg);
+    BaseType_t woken = pdFALSE;
+    if (self->_task != nullptr) {
+        vTaskNotifyGiveFromISR(self->_task, &woken);
+    }
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+#endif // ESP32
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Adquisición en tarea dedicada (ESP32)
+ *
+ * Ejecuta la adquisición en una tarea FreeRTOS fijada a un núcleo y entrega
+ * los registros ADS1220_Sample por una cola. La configuración del ADC desde
+ * otras tareas se envía como comandos que la tarea aplica entre conversiones,
+ * de modo que el estado del driver (_reg*, buffers, _last*) solo lo toca la
+ * tarea de adquisición y el jitter de muestreo no depende de la carga del
+ * otro núcleo.
+ *
+ * Solo disponible en ESP32. Mientras la tarea está activa no deben llamarse
+ * directamente los métodos del objeto ADS1220_NTC_Extended asociado.
+ ******************************************************************************/
+
+#ifndef ADS1220_ASYNC_ESP32_H
+#define ADS1220_ASYNC_ESP32_H
+
+#if defined(ESP32)
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include "ADS1220_NTC_Extended.h"
+
+// ===== PARÁMETROS POR DEFECTO =====
+#define ADS1220_ASYNC_STACK_SIZE        4096
+#define ADS1220_ASYNC_PRIORITY          5
+#define ADS1220_ASYNC_CORE              0
+#define ADS1220_ASYNC_QUEUE_LENGTH      64
+#define ADS1220_ASYNC_COMMAND_LENGTH    8
+
+class ADS1220_AsyncESP32 {
+public:
+    /**
+     * @brief Constructor
+     * @param adc Driver ya inicializado con begin()
+     */
+    ADS1220_AsyncESP32(ADS1220_NTC_Extended &adc);
+    ~ADS1220_AsyncESP32();
+
+    /**
+     * @brief Crea la tarea de adquisición
+     * @param channelMask Canales a barrer (bit 0 = CHANNEL_0, bit 1 = CHANNEL_1)
+     * @param core Núcleo donde se fija la tarea (0 o 1)
+     * @param priority Prioridad FreeRTOS de la tarea
+     * @param queueLength Capacidad de la cola de muestras
+     * @return true si la tarea y las colas se crearon
+     *
+     * Si el driver tiene pin DRDY, la tarea duerme hasta la interrupción de
+     * datos listos; si no, revisa cada tick.
+     */
+    bool begin(uint8_t channelMask = 0x03, BaseType_t core = ADS1220_ASYNC_CORE,
+               UBaseType_t priority = ADS1220_ASYNC_PRIORITY,
+               uint16_t queueLength = ADS1220_ASYNC_QUEUE_LENGTH);
+
+    /**
+     * @brief Detiene la tarea (espera a que termine la conversión en curso)
+     */
+    void end();
+
+    /**
+     * @brief Obtiene la siguiente muestra de la cola
+     * @param sample Muestra de salida
+     * @param wait Ticks máximos de espera (0 = no bloquear)
+     * @return true si se obtuvo una muestra
+     */
+    bool receive(ADS1220_Sample &sample, TickType_t wait = 0);
+
+    /**
+     * @brief Muestras pendientes en la cola
+     */
+    uint16_t available();
+
+    /**
+     * @brief Muestras descartadas porque la cola estaba llena
+     */
+    uint32_t droppedSamples();
+
+    // ===== CONFIGURACIÓN SEGURA ENTRE TAREAS =====
+    // Cada setter encola un comando; la tarea lo aplica antes de iniciar la
+    // siguiente lectura. Devuelven false si la cola de comandos está llena.
+    bool setScanChannels(uint8_t channelMask);
+    bool setGain(uint8_t gain);
+    bool setPGABypass(bool bypass);
+    bool setDataRate(uint8_t dataRate);
+    bool setChannelMode(ADS1220_Channel channel, ADS1220_SensorMode mode);
+    bool setIDACCurrent(float idacCurrent_uA);
+    bool setChopMode(ADS1220_Channel channel, bool enable);
+    bool setReferenceResistor(ADS1220_Channel channel, float referenceResistance);
+    bool setSettlingTime(uint32_t settleTime_us);
+    bool setHeatFluxSensorTemperature(ADS1220_Channel channel, float sensorTemp);
+    bool calibrateOffset(uint8_t samples = 8);
+
+private:
+    enum CommandType : uint8_t {
+        CMD_STOP,
+        CMD_SCAN_CHANNELS,
+        CMD_GAIN,
+        CMD_PGA_BYPASS,
+        CMD_DATA_RATE,
+        CMD_CHANNEL_MODE,
+        CMD_IDAC_CURRENT,
+        CMD_CHOP_MODE,
+        CMD_REFERENCE_RESISTOR,
+        CMD_SETTLING_TIME,
+        CMD_SENSOR_TEMPERATURE,
+        CMD_CALIBRATE_OFFSET
+    };
+
+    struct Command {
+        CommandType type;
+        uint8_t channel;
+        uint32_t u;                      // Argumento entero
+        float f;                         // Argumento flotante
+    };
+
+    ADS1220_NTC_Extended &_adc;
+    TaskHandle_t _task;
+    QueueHandle_t _sampleQueue;
+    QueueHandle_t _commandQueue;
+    volatile bool _running;
+    volatile uint32_t _dropped;
+    uint8_t _channelMask;
+    uint8_t _nextChannel;
+
+    bool _sendCommand(CommandType type, uint8_t channel, uint32_t u, float f);
+    void _applyCommand(const Command &command);
+    void _run();
+    static void _taskEntry(void* arg);
+    static void IRAM_ATTR _drdyISR(void* arg);
+};
+
+#endif // ESP32
+
+#endif // ADS1220_ASYNC_ESP32_H
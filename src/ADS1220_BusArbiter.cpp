@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Árbitro de bus compartido
+ ******************************************************************************/
+
+#include "ADS1220_BusArbiter.h"
+
+ADS1220_BusArbiter::ADS1220_BusArbiter() {
+    _deviceCount = 0;
+    _locked = false;
+    _samples = 0;
+    _deferred = 0;
+    _timeouts = 0;
+}
+
+bool ADS1220_BusArbiter::addDevice(ADS1220_NTC_Extended &adc, uint8_t channelMask) {
+    if (_deviceCount >= ADS1220_ARBITER_MAX_DEVICES) {
+        return false;
+    }
+    _devices[_deviceCount].adc = &adc;
+    _devices[_deviceCount].channelMask = channelMask & 0x03;
+    _devices[_deviceCount].nextChannel = 0;
+    _deviceCount++;
+    return true;
+}
+
+void ADS1220_BusArbiter::setScanChannels(ADS1220_NTC_Extended &adc, uint8_t channelMask) {
+    for (uint8_t i = 0; i < _deviceCount; i++) {
+        if (_devices[i].adc == &adc) {
+            _devices[i].channelMask = channelMask & 0x03;
+        }
+    }
+}
+
+uint8_t ADS1220_BusArbiter::service() {
+    if (_locked) {
+        return 0;
+    }
+
+    uint8_t completed = 0;
+    uint32_t wait_us;
+
+    // 1) Conversiones listas: todas las lecturas antes que cualquier escritura
+    //    (poll() solo toca el bus si el dato está listo; también vigila el timeout)
+    for (uint8_t i = 0; i < _deviceCount; i++) {
+        if (_devices[i].adc->busRequest(wait_us) == BUS_READ) {
+            if (_pollDevice(_devices[i])) {
+                completed++;
+            }
+        }
+    }
+
+    // 2) START/SYNC y configuración de nuevas lecturas, en transacciones contiguas
+    for (uint8_t i = 0; i < _deviceCount; i++) {
+        ADS1220_BusRequest request = _devices[i].adc->busRequest(wait_us);
+        if (request == BUS_WRITE && wait_us == 0) {
+            _pollDevice(_devices[i]);
+        } else if (request == BUS_NONE) {
+            _startNext(_devices[i]);
+        }
+    }
+
+    return completed;
+}
+
+bool ADS1220_BusArbiter::acquire(uint32_t duration_us) {
+    if (_locked) {
+        return false;
+    }
+
+    // Negar el bus si una conversión quedará lista durante el acceso
+    uint32_t wait_us;
+    for (uint8_t i = 0; i < _deviceCount; i++) {
+        if (_devices[i].adc->busRequest(wait_us) == BUS_READ && wait_us <= duration_us) {
+            _deferred++;
+            return false;
+        }
+    }
+
+    _locked = true;
+    return true;
+}
+
+void ADS1220_BusArbiter::release() {
+    _locked = false;
+}
+
+// =============================================================================
+// FUNCIONES PRIVADAS
+// =============================================================================
+
+bool ADS1220_BusArbiter::_pollDevice(Device &device) {
+    ADS1220_Sample sample;
+    ADS1220_ReadStatus status = device.adc->poll(sample);
+
+    if (status == READ_READY) {
+        _samples++;
+        return true;
+    }
+    if (status == READ_TIMEOUT) {
+        _timeouts++;
+    }
+    return false;
+}
+
+void ADS1220_BusArbiter::_startNext(Device &device) {
+    if (device.channelMask == 0) {
+        return;
+    }
+
+    while ((device.channelMask & (1 << device.nextChannel)) == 0) {
+        device.nextChannel = (device.nextChannel + 1) & 0x01;
+    }
+    device.adc->startRead(device.nextChannel == 0 ? CHANNEL_0 : CHANNEL_1);
+    device.nextChannel = (device.nextChannel + 1) & 0x01;
+}
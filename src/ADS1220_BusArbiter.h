@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Árbitro de bus compartido
+ *
+ * Coordina varios ADS1220_NTC_Extended (y otros dispositivos SPI) sobre el
+ * mismo bus. Cada llamada a service():
+ *   1. Lee primero todas las conversiones listas (RDATA), en cuanto DRDY
+ *      o el tiempo de conversión lo permiten.
+ *   2. Después agrupa, en transacciones contiguas, los START/SYNC pendientes
+ *      y la configuración de las siguientes lecturas de cada instancia.
+ *
+ * Otro dispositivo del bus pide turno con acquire()/release(); el árbitro lo
+ * niega si alguna conversión va a estar lista dentro de la ventana pedida,
+ * para que su tráfico no caiga entre un DRDY y su lectura.
+ *
+ * Las muestras quedan en el buffer de cada driver (availableSamples() /
+ * readSample()). Mientras un driver está registrado, no deben llamarse sus
+ * lecturas bloqueantes ni startRead()/poll() desde fuera del árbitro.
+ ******************************************************************************/
+
+#ifndef ADS1220_BUS_ARBITER_H
+#define ADS1220_BUS_ARBITER_H
+
+#include <Arduino.h>
+#include "ADS1220_NTC_Extended.h"
+
+#define ADS1220_ARBITER_MAX_DEVICES     4
+
+class ADS1220_BusArbiter {
+public:
+    ADS1220_BusArbiter();
+
+    /**
+     * @brief Registra un driver ya inicializado con begin()
+     * @param adc Driver
+     * @param channelMask Canales a barrer (bit 0 = CHANNEL_0, bit 1 = CHANNEL_1)
+     * @return false si ya hay ADS1220_ARBITER_MAX_DEVICES registrados
+     */
+    bool addDevice(ADS1220_NTC_Extended &adc, uint8_t channelMask = 0x03);
+
+    /**
+     * @brief Cambia los canales barridos de un driver registrado
+     */
+    void setScanChannels(ADS1220_NTC_Extended &adc, uint8_t channelMask);
+
+    /**
+     * @brief Atiende el bus; llamar en cada iteración de loop()
+     * @return Número de muestras completadas en esta llamada
+     */
+    uint8_t service();
+
+    /**
+     * @brief Pide el bus para otro dispositivo SPI
+     * @param duration_us Duración estimada del acceso [µs]
+     * @return true si el bus queda reservado; false si una conversión estará
+     *         lista antes (reintentar tras el siguiente service())
+     */
+    bool acquire(uint32_t duration_us = 100);
+
+    /**
+     * @brief Libera el bus reservado con acquire()
+     */
+    void release();
+
+    // ===== ESTADÍSTICAS =====
+    uint32_t samplesServiced() { return _samples; }
+    uint32_t deferredAcquires() { return _deferred; }
+    uint32_t timeouts() { return _timeouts; }
+
+private:
+    struct Device {
+        ADS1220_NTC_Extended *adc;
+        uint8_t channelMask;
+        uint8_t nextChannel;
+    };
+
+    Device _devices[ADS1220_ARBITER_MAX_DEVICES];
+    uint8_t _deviceCount;
+    bool _locked;
+    uint32_t _samples;
+    uint32_t _deferred;
+    uint32_t _timeouts;
+
+    bool _pollDevice(Device &device);
+    void _startNext(Device &device);
+};
+
+#endif // ADS1220_BUS_ARBITER_H
@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Compensación de respuesta dinámica
+ ******************************************************************************/
+
+#include "ADS1220_Compensator.h"
+
+static float absf(float value) {
+    return (value < 0.0f) ? -value : value;
+}
+
+ADS1220_Compensator::ADS1220_Compensator() {
+    _maxGain = ADS1220_COMP_DEFAULT_MAX_GAIN;
+    _enabled = false;
+    for (uint8_t i = 0; i < 2; i++) {
+        _stage[i].tau = 0.0f;
+        _stage[i].lag = 0.0f;
+    }
+    _idState = ID_OFF;
+    _idTau = 0.0f;
+    reset();
+}
+
+void ADS1220_Compensator::configure(float tau1_s, float tau2_s, float maxGain) {
+    if (maxGain < 1.0f) maxGain = 1.0f;
+    if (tau1_s < 0.0f) tau1_s = 0.0f;
+    if (tau2_s < 0.0f) tau2_s = 0.0f;
+
+    _maxGain = maxGain;
+    _stage[0].tau = tau1_s;
+    _stage[0].lag = tau1_s / maxGain;
+    _stage[1].tau = tau2_s;
+    _stage[1].lag = tau2_s / maxGain;
+    _enabled = (tau1_s > 0.0f) || (tau2_s > 0.0f);
+
+    // Arranque sin salto: las etapas parten de la última entrada
+    for (uint8_t i = 0; i < 2; i++) {
+        _stage[i].prevOut = _stage[i].prevIn;
+    }
+}
+
+void ADS1220_Compensator::reset() {
+    for (uint8_t i = 0; i < 2; i++) {
+        _stage[i].prevIn = 0.0f;
+        _stage[i].prevOut = 0.0f;
+    }
+    _first = true;
+}
+
+float ADS1220_Compensator::update(float value, uint32_t dt_us) {
+    float dt = (float)dt_us * 1e-6f;
+
+    if (_first) {
+        for (uint8_t i = 0; i < 2; i++) {
+            _stage[i].prevIn = value;
+            _stage[i].prevOut = value;
+        }
+        _first = false;
+        if (_idState != ID_OFF) {
+            _identify(value, 0.0f);
+        }
+        return value;
+    }
+
+    if (_idState != ID_OFF) {
+        _identify(value, dt);
+    }
+
+    if (!_enabled || _idState != ID_OFF || dt <= 0.0f) {
+        // Bypass: mantener el estado cebado para habilitar sin salto
+        for (uint8_t i = 0; i < 2; i++) {
+            _stage[i].prevIn = value;
+            _stage[i].prevOut = value;
+        }
+        return value;
+    }
+
+    // τ_lag·(y - y[n-1])/dt + y = τ·(x - x[n-1])/dt + x
+    for (uint8_t i = 0; i < 2; i++) {
+        Stage &stage = _stage[i];
+        if (stage.tau <= 0.0f) {
+            continue;
+        }
+        float out = (stage.lag * stage.prevOut + stage.tau * (value - stage.prevIn) + value * dt) / (stage.lag + dt);
+        stage.prevIn = value;
+        stage.prevOut = out;
+        value = out;
+    }
+    return value;
+}
+
+// =============================================================================
+// IDENTIFICACIÓN POR ESCALÓN
+// =============================================================================
+
+void ADS1220_Compensator::startIdentification(float stepThreshold) {
+    _idThreshold = absf(stepThreshold);
+    _idBaseline = 0.0f;
+    _idBaselineCount = 0;
+    _idTau = 0.0f;
+    _idState = ID_BASELINE;
+}
+
+void ADS1220_Compensator::_identify(float value, float dt) {
+    if (_idState == ID_BASELINE) {
+        float dev = value - _idBaseline;
+        if (_idBaselineCount >= 4 && absf(dev) > _idThreshold) {
+            // Escalón: t0 = muestra anterior (todavía en la línea base)
+            _idState = ID_STEP;
+            _idElapsed = dt;
+            _idArea = 0.5f * dev * dt;
+            _idPrevDev = dev;
+            _idRef = value;
+            _idRefTime = _idElapsed;
+            _idSettleSum = value;
+            _idSettleCount = 1;
+            return;
+        }
+        // Media acumulada; pasa a media exponencial tras 64 muestras
+        if (_idBaselineCount < 64) {
+            _idBaselineCount++;
+        }
+        _idBaseline += dev / (float)_idBaselineCount;
+        return;
+    }
+
+    // ID_STEP: área por trapecios
+    float dev = value - _idBaseline;
+    _idArea += 0.5f * (_idPrevDev + dev) * dt;
+    _idElapsed += dt;
+    _idPrevDev = dev;
+
+    // Banda de asentamiento: 2% del escalón acumulado (mín. un cuarto del umbral)
+    float band = 0.02f * absf(dev);
+    if (band < 0.25f * _idThreshold) {
+        band = 0.25f * _idThreshold;
+    }
+    if (absf(value - _idRef) > band) {
+        _idRef = value;
+        _idRefTime = _idElapsed;
+        _idSettleSum = 0.0f;
+        _idSettleCount = 0;
+    }
+    if (_idSettleCount < 255) {
+        _idSettleSum += value;
+        _idSettleCount++;
+    }
+
+    // Asentado: dentro de la banda durante la mitad del tiempo que tardó en llegar
+    float stable = _idElapsed - _idRefTime;
+    if (_idSettleCount >= 4 && stable >= 0.5f * _idRefTime) {
+        float step = _idSettleSum / (float)_idSettleCount - _idBaseline;
+        float tau = (absf(step) > _idThreshold) ? _idElapsed - _idArea / step : 0.0f;
+        _idState = ID_OFF;
+        if (tau > 0.0f) {
+            _idTau = tau;
+            configure(tau, 0.0f, _maxGain);
+        }
+        return;
+    }
+
+    if (_idElapsed > ADS1220_COMP_IDENT_TIMEOUT_S) {
+        _idState = ID_OFF;  // No se asentó: se conserva la configuración anterior
+    }
+}
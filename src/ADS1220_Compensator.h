@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Compensación de respuesta dinámica
+ *
+ * Compensador de adelanto (inversa de la dinámica del sensor) de primer o
+ * segundo orden. Cada etapa es
+ *
+ *            τ·s + 1
+ *   C(s) = -----------      con  τ_lag = τ / maxGain
+ *          τ_lag·s + 1
+ *
+ * y cancela el polo térmico 1/(τ·s + 1) del sensor (gSKIN, NTC encapsulado):
+ * la respuesta conjunta queda con constante τ_lag. maxGain limita cuánto se
+ * amplifica el ruido de alta frecuencia (maxGain por etapa).
+ *
+ * Discretización por Euler hacia atrás con el dt real de cada muestra.
+ *
+ * La identificación automática mide τ con el método del área sobre un
+ * escalón: τ = T - ∫(y - y0)dt / (yf - y0), que no necesita conocer yf de
+ * antemano y, en sensores de orden mayor, da la suma de constantes de tiempo.
+ *
+ * Este archivo no depende de Arduino.
+ ******************************************************************************/
+
+#ifndef ADS1220_COMPENSATOR_H
+#define ADS1220_COMPENSATOR_H
+
+#include <stdint.h>
+
+#define ADS1220_COMP_DEFAULT_MAX_GAIN   10.0f   // Ganancia de alta frecuencia por etapa
+#define ADS1220_COMP_IDENT_TIMEOUT_S    1000.0f // Duración máxima de un escalón [s]
+
+class ADS1220_Compensator {
+public:
+    ADS1220_Compensator();
+
+    /**
+     * @brief Configura las etapas de adelanto
+     * @param tau1_s Constante de tiempo principal del sensor [s] (0 = sin compensar)
+     * @param tau2_s Segunda constante de tiempo [s] (0 = primer orden)
+     * @param maxGain Ganancia de alta frecuencia de cada etapa (> 1)
+     */
+    void configure(float tau1_s, float tau2_s = 0.0f, float maxGain = ADS1220_COMP_DEFAULT_MAX_GAIN);
+    bool isEnabled() const { return _enabled; }
+    float getTimeConstant(uint8_t stage) const { return (stage < 2) ? _stage[stage].tau : 0.0f; }
+
+    /**
+     * @brief Reinicia el estado (la siguiente muestra pasa sin cambios)
+     */
+    void reset();
+
+    /**
+     * @brief Procesa una muestra
+     * @param value Entrada (ya filtrada)
+     * @param dt_us Tiempo desde la muestra anterior [µs]
+     * @return Valor compensado (la entrada si está deshabilitado o identificando)
+     */
+    float update(float value, uint32_t dt_us);
+
+    /**
+     * @brief Identifica τ en el próximo escalón de la entrada
+     * @param stepThreshold Desviación respecto de la línea base que marca el
+     *        escalón (varias veces el ruido, en unidades de la entrada)
+     *
+     * Mide la línea base con la entrada estable, detecta el escalón, espera a
+     * que se asiente y configura una etapa de primer orden con el τ medido.
+     */
+    void startIdentification(float stepThreshold);
+    void cancelIdentification() { _idState = ID_OFF; }
+    bool isIdentifying() const { return _idState != ID_OFF; }
+
+    /**
+     * @brief τ de la última identificación [s] (0 si no terminó o falló)
+     */
+    float getIdentifiedTimeConstant() const { return _idTau; }
+
+private:
+    struct Stage {
+        float tau;                       // Constante compensada [s]
+        float lag;                       // Constante residual τ/maxGain [s]
+        float prevIn;
+        float prevOut;
+    };
+
+    enum IdState : uint8_t {
+        ID_OFF,
+        ID_BASELINE,                     // Promediando la entrada previa al escalón
+        ID_STEP                          // Integrando el área hasta el asentamiento
+    };
+
+    Stage _stage[2];
+    float _maxGain;
+    bool _enabled;
+    bool _first;
+
+    IdState _idState;
+    uint8_t _idBaselineCount;
+    uint8_t _idSettleCount;
+    float _idThreshold;
+    float _idBaseline;                   // y0
+    float _idPrevDev;                    // y - y0 de la muestra anterior
+    float _idArea;                       // ∫(y - y0)dt [unidades·s]
+    float _idElapsed;                    // Tiempo desde el escalón [s]
+    float _idRef;                        // Valor de referencia de la banda de asentamiento
+    float _idRefTime;                    // Última salida de la banda [s]
+    float _idSettleSum;                  // Suma de muestras dentro de la banda
+    float _idTau;
+
+    void _identify(float value, float dt);
+};
+
+#endif // ADS1220_COMPENSATOR_H
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Configuración persistente
+ ******************************************************************************/
+
+#include "ADS1220_Config.h"
+#include "ADS1220_Protocol.h"
+#include <string.h>
+
+// =============================================================================
+// AUXILIARES LITTLE-ENDIAN
+// =============================================================================
+
+static uint8_t* putU16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)(value & 0xFF);
+    out[1] = (uint8_t)(value >> 8);
+    return out + 2;
+}
+
+static uint8_t* putU32(uint8_t* out, uint32_t value) {
+    out = putU16(out, (uint16_t)(value & 0xFFFF));
+    return putU16(out, (uint16_t)(value >> 16));
+}
+
+static uint8_t* putFloat(uint8_t* out, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return putU32(out, bits);
+}
+
+static uint16_t getU16(const uint8_t* &in) {
+    uint16_t value = (uint16_t)in[0] | ((uint16_t)in[1] << 8);
+    in += 2;
+    return value;
+}
+
+static uint32_t getU32(const uint8_t* &in) {
+    uint32_t low = getU16(in);
+    return low | ((uint32_t)getU16(in) << 16);
+}
+
+static float getFloat(const uint8_t* &in) {
+    uint32_t bits = getU32(in);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// =============================================================================
+// CODIFICACIÓN
+// =============================================================================
+
+size_t ADS1220_encodeConfig(uint8_t* out, const ADS1220_Config &config) {
+    uint8_t* p = out;
+
+    *p++ = ADS1220_CONFIG_MAGIC0;
+    *p++ = ADS1220_CONFIG_MAGIC1;
+    *p++ = ADS1220_CONFIG_VERSION;
+    *p++ = ADS1220_CONFIG_PAYLOAD_SIZE;
+
+    for (uint8_t i = 0; i < 4; i++) *p++ = config.registers[i];
+    for (uint8_t ch = 0; ch < 2; ch++) *p++ = config.channelMode[ch];
+    for (uint8_t ch = 0; ch < 2; ch++) *p++ = config.chopEnabled[ch];
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        p = putFloat(p, config.ntcA[ch]);
+        p = putFloat(p, config.ntcB[ch]);
+        p = putFloat(p, config.ntcC[ch]);
+    }
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        p = putFloat(p, config.hfSo[ch]);
+        p = putFloat(p, config.hfSc[ch]);
+        p = putFloat(p, config.hfTo[ch]);
+        p = putFloat(p, config.hfArea[ch]);
+    }
+    p = putFloat(p, config.idacCurrent);
+    for (uint8_t ch = 0; ch < 2; ch++) p = putFloat(p, config.refResistance[ch]);
+    for (uint8_t i = 0; i < 8; i++) p = putU16(p, (uint16_t)config.offsetTable[i]);
+    *p++ = config.offsetValid;
+    *p++ = config.offsetCorrection;
+    *p++ = config.avgSize;
+    p = putU32(p, config.settleTime_us);
+    for (uint8_t ch = 0; ch < 2; ch++) p = putFloat(p, config.hfSensorTemp[ch]);
+    for (uint8_t ch = 0; ch < 2; ch++) *p++ = config.modelEnabled[ch];
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        p = putFloat(p, config.modelMinTemp[ch]);
+        p = putFloat(p, config.modelMaxTemp[ch]);
+    }
+
+    uint16_t crc = ADS1220_crc16(out + 2, (size_t)(p - out) - 2);
+    p = putU16(p, crc);
+    return (size_t)(p - out);
+}
+
+// =============================================================================
+// DECODIFICACIÓN
+// =============================================================================
+
+bool ADS1220_decodeConfig(const uint8_t* in, size_t length, ADS1220_Config &config) {
+    if (length < ADS1220_CONFIG_SIZE ||
+        in[0] != ADS1220_CONFIG_MAGIC0 || in[1] != ADS1220_CONFIG_MAGIC1 ||
+        in[2] != ADS1220_CONFIG_VERSION || in[3] != ADS1220_CONFIG_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    const uint8_t* crcPos = in + ADS1220_CONFIG_SIZE - 2;
+    uint16_t crc = ADS1220_crc16(in + 2, ADS1220_CONFIG_SIZE - 4);
+    if (getU16(crcPos) != crc) {
+        return false;
+    }
+
+    // Decodificar en una copia: config no cambia si algo falla
+    ADS1220_Config decoded;
+    const uint8_t* p = in + ADS1220_CONFIG_HEADER_SIZE;
+
+    for (uint8_t i = 0; i < 4; i++) decoded.registers[i] = *p++;
+    for (uint8_t ch = 0; ch < 2; ch++) decoded.channelMode[ch] = *p++;
+    for (uint8_t ch = 0; ch < 2; ch++) decoded.chopEnabled[ch] = *p++;
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        decoded.ntcA[ch] = getFloat(p);
+        decoded.ntcB[ch] = getFloat(p);
+        decoded.ntcC[ch] = getFloat(p);
+    }
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        decoded.hfSo[ch] = getFloat(p);
+        decoded.hfSc[ch] = getFloat(p);
+        decoded.hfTo[ch] = getFloat(p);
+        decoded.hfArea[ch] = getFloat(p);
+    }
+    decoded.idacCurrent = getFloat(p);
+    for (uint8_t ch = 0; ch < 2; ch++) decoded.refResistance[ch] = getFloat(p);
+    for (uint8_t i = 0; i < 8; i++) decoded.offsetTable[i] = (int16_t)getU16(p);
+    decoded.offsetValid = *p++;
+    decoded.offsetCorrection = *p++;
+    decoded.avgSize = *p++;
+    decoded.settleTime_us = getU32(p);
+    for (uint8_t ch = 0; ch < 2; ch++) decoded.hfSensorTemp[ch] = getFloat(p);
+    for (uint8_t ch = 0; ch < 2; ch++) decoded.modelEnabled[ch] = *p++;
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        decoded.modelMinTemp[ch] = getFloat(p);
+        decoded.modelMaxTemp[ch] = getFloat(p);
+    }
+
+    config = decoded;
+    return true;
+}
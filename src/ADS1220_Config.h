@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Configuración persistente
+ *
+ * Imagen serializada de la configuración y calibración del driver para
+ * guardarla en EEPROM (AVR) o NVS (ESP32) y recuperarla tras un reinicio.
+ * El formato es fijo y little-endian (no depende del empaquetado de structs
+ * del compilador), así que una imagen guardada en un ESP32 se puede cargar en
+ * un Mega o enviar al host. Este archivo no depende de Arduino.
+ *
+ * Imagen (ADS1220_CONFIG_SIZE bytes):
+ *   Offset  Tamaño  Campo
+ *   0       2       Marca 0xA2 0x20
+ *   2       1       Versión (ADS1220_CONFIG_VERSION)
+ *   3       1       Longitud de los datos (ADS1220_CONFIG_PAYLOAD_SIZE)
+ *   4       4       Registros REG0..REG3 (shadow)
+ *   8       2       Modo por canal (ADS1220_SensorMode)
+ *   10      2       Chopper por canal
+ *   12      24      Steinhart-Hart A, B, C por canal (float32)
+ *   36      32      gSKIN So, Sc, To, área por canal (float32)
+ *   68      4       Corriente IDAC medida [A] (float32)
+ *   72      8       Resistencia de referencia por canal [Ω] (float32)
+ *   80      16      Tabla de offsets por ganancia (int16)
+ *   96      1       Offsets válidos (bit n = ganancia n)
+ *   97      1       Corrección de offset habilitada
+ *   98      1       Tamaño del promedio móvil
+ *   99      4       Tiempo de asentamiento [µs] (uint32)
+ *   103     8       Temperatura del sensor de flujo por canal [°C] (float32)
+ *   111     2       Modelo directo código -> T habilitado por canal
+ *   113     16      Rango del modelo directo mín., máx. por canal [°C] (float32)
+ *   129     2       CRC-16/CCITT-FALSE de los bytes 2 .. 128
+ *
+ * La versión 2 añadió los campos 103 .. 128 (entradas del cálculo que la
+ * reproducción de grabaciones necesita); una imagen de versión 1 no se carga.
+ ******************************************************************************/
+
+#ifndef ADS1220_CONFIG_H
+#define ADS1220_CONFIG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ADS1220_CONFIG_MAGIC0           0xA2
+#define ADS1220_CONFIG_MAGIC1           0x20
+#define ADS1220_CONFIG_VERSION          2
+#define ADS1220_CONFIG_HEADER_SIZE      4
+#define ADS1220_CONFIG_PAYLOAD_SIZE     125
+#define ADS1220_CONFIG_SIZE             (ADS1220_CONFIG_HEADER_SIZE + ADS1220_CONFIG_PAYLOAD_SIZE + 2)
+
+struct ADS1220_Config {
+    uint8_t registers[4];
+    uint8_t channelMode[2];
+    uint8_t chopEnabled[2];
+    float ntcA[2], ntcB[2], ntcC[2];
+    float hfSo[2], hfSc[2], hfTo[2], hfArea[2];
+    float idacCurrent;          // [A]
+    float refResistance[2];     // [Ω], 0 = referencia interna
+    int16_t offsetTable[8];
+    uint8_t offsetValid;
+    uint8_t offsetCorrection;
+    uint8_t avgSize;
+    uint32_t settleTime_us;
+    float hfSensorTemp[2];      // [°C]
+    uint8_t modelEnabled[2];
+    float modelMinTemp[2], modelMaxTemp[2];
+};
+
+/**
+ * @brief Serializa la configuración
+ * @param out Buffer de al menos ADS1220_CONFIG_SIZE bytes
+ * @return Bytes escritos (ADS1220_CONFIG_SIZE)
+ */
+size_t ADS1220_encodeConfig(uint8_t* out, const ADS1220_Config &config);
+
+/**
+ * @brief Valida (marca, versión, longitud y CRC) y deserializa una imagen
+ * @return false si la imagen no es válida; config no se modifica
+ */
+bool ADS1220_decodeConfig(const uint8_t* in, size_t length, ADS1220_Config &config);
+
+#endif // ADS1220_CONFIG_H
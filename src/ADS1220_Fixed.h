@@ -0,0 +1,276 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Front-end especializado en compilación
+ *
+ * Alternativa a ADS1220_NTC_Extended para montajes fijos: pines, canales,
+ * modo de cada canal, data rate, ganancia e IDAC son parámetros de plantilla.
+ * Los bytes de registro, el tiempo de conversión y los factores de escala se
+ * calculan con constexpr, y el canal de cada lectura es un parámetro de la
+ * función (readTemperature<CHANNEL_0>()), así que el camino de lectura
+ * generado no tiene decisiones en tiempo de ejecución sobre canal, modo,
+ * ganancia o pin DRDY.
+ *
+ * Cubre solo la lectura básica (bloqueante) de NTC y flujo térmico; para
+ * chopper, ratiométrico, lectura no bloqueante, offsets o reconfiguración en
+ * marcha se usa la clase ADS1220_NTC_Extended.
+ *
+ * Ejemplo:
+ *   ADS1220_Fixed<5, 4, 0x03, MODE_NTC, MODE_HEAT_FLUX, ADS1220_DR_20SPS,
+ *                 ADS1220_GAIN_1, 50> sensor;
+ *   sensor.begin();
+ *   float t   = sensor.readTemperature<CHANNEL_0>();
+ *   float phi = sensor.readHeatFlux<CHANNEL_1>(t);
+ ******************************************************************************/
+
+#ifndef ADS1220_FIXED_H
+#define ADS1220_FIXED_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "ADS1220_NTC_Extended.h"
+#include "ADS1220_SPITransport.h"
+
+// ===== CÁLCULOS EN COMPILACIÓN =====
+struct ADS1220_FixedMath {
+    // Ganancia numérica a partir de los bits GAIN[3:1] de REG0
+    static constexpr uint8_t gainValue(uint8_t gainBits) {
+        return (uint8_t)(1 << ((gainBits >> 1) & 0x07));
+    }
+
+    // Bits IDAC[2:0] de REG2; solo valores exactos del ADS1220 (0 = inválido)
+    static constexpr uint8_t idacBits(uint16_t current_uA) {
+        return current_uA == 10   ? ADS1220_IDAC_10UA   :
+               current_uA == 50   ? ADS1220_IDAC_50UA   :
+               current_uA == 100  ? ADS1220_IDAC_100UA  :
+               current_uA == 250  ? ADS1220_IDAC_250UA  :
+               current_uA == 500  ? ADS1220_IDAC_500UA  :
+               current_uA == 1000 ? ADS1220_IDAC_1000UA :
+               current_uA == 1500 ? ADS1220_IDAC_1500UA : ADS1220_IDAC_OFF;
+    }
+
+    // Periodo nominal en modo normal para los bits DR[7:5] de REG1
+    static constexpr uint32_t conversionTime_us(uint8_t dataRate) {
+        return ((dataRate >> 5) & 0x07) == 0 ? 50000UL :
+               ((dataRate >> 5) & 0x07) == 1 ? 22222UL :
+               ((dataRate >> 5) & 0x07) == 2 ? 11111UL :
+               ((dataRate >> 5) & 0x07) == 3 ? 5714UL  :
+               ((dataRate >> 5) & 0x07) == 4 ? 3030UL  :
+               ((dataRate >> 5) & 0x07) == 5 ? 1667UL  : 1000UL;
+    }
+};
+
+// ===== CLASE PLANTILLA =====
+template <uint8_t CS_PIN,
+          uint8_t DRDY_PIN,
+          uint8_t CHANNELS,                       // bit 0 = CHANNEL_0, bit 1 = CHANNEL_1
+          ADS1220_SensorMode MODE0,
+          ADS1220_SensorMode MODE1,
+          uint8_t DATA_RATE = ADS1220_DR_90SPS,
+          uint8_t GAIN = ADS1220_GAIN_1,
+          uint16_t IDAC_UA = 10>
+class ADS1220_Fixed {
+    static_assert(CHANNELS >= 0x01 && CHANNELS <= 0x03, "CHANNELS debe ser 0x01, 0x02 o 0x03");
+    static_assert((DATA_RATE & 0x1F) == 0, "DATA_RATE debe ser una constante ADS1220_DR_*");
+    static_assert((GAIN & 0xF1) == 0, "GAIN debe ser una constante ADS1220_GAIN_*");
+    static_assert(IDAC_UA == 0 || ADS1220_FixedMath::idacBits(IDAC_UA) != ADS1220_IDAC_OFF,
+                  "IDAC_UA debe ser 10, 50, 100, 250, 500, 1000 o 1500");
+
+public:
+    // ===== CONSTANTES DERIVADAS =====
+    static constexpr bool SINGLE_CHANNEL = (CHANNELS != 0x03);
+    static constexpr bool USE_DRDY = (DRDY_PIN != 255);
+    static constexpr uint8_t FIRST_CHANNEL = (CHANNELS & 0x01) ? 0 : 1;
+
+    static constexpr uint8_t GAIN_VALUE = ADS1220_FixedMath::gainValue(GAIN);
+    static constexpr float VOLTS_PER_CODE = ADS1220_VREF / ((float)GAIN_VALUE * (float)ADS1220_MAX_CODE);
+    static constexpr float OHMS_PER_CODE = (IDAC_UA == 0) ? 0.0f : VOLTS_PER_CODE / ((float)IDAC_UA * 1e-6f);
+
+    static constexpr uint32_t CONVERSION_US = ADS1220_FixedMath::conversionTime_us(DATA_RATE);
+    static constexpr uint32_t WAIT_US = CONVERSION_US + CONVERSION_US / 8 + 100;
+
+    static constexpr uint8_t REG1 = DATA_RATE | ADS1220_MODE_NORMAL | ADS1220_CM_CONTINUOUS;
+
+    // IDAC1 -> AIN0 y/o IDAC2 -> AIN2 para los canales NTC habilitados
+    static constexpr uint8_t REG3 =
+        (((CHANNELS & 0x01) && MODE0 == MODE_NTC && IDAC_UA != 0) ? (ADS1220_IDAC_AIN0 << 5) : 0) |
+        (((CHANNELS & 0x02) && MODE1 == MODE_NTC && IDAC_UA != 0) ? (ADS1220_IDAC_AIN2 << 2) : 0);
+
+    static constexpr uint8_t reg0(uint8_t ch) {
+        return (ch == 0 ? ADS1220_MUX_AIN0_AIN1 : ADS1220_MUX_AIN2_AIN3) | GAIN | ADS1220_PGA_ENABLED;
+    }
+
+    static constexpr uint8_t reg2(uint8_t ch) {
+        return ADS1220_VREF_INTERNAL | ADS1220_REJECT_OFF |
+               (((ch == 0 ? MODE0 : MODE1) == MODE_NTC) ? ADS1220_FixedMath::idacBits(IDAC_UA) : ADS1220_IDAC_OFF);
+    }
+
+    // ===== CONSTRUCTOR =====
+    ADS1220_Fixed() : _transport(CS_PIN) {
+        for (uint8_t ch = 0; ch < 2; ch++) {
+            _ntc_A[ch] = NTC_A_COEFF;
+            _ntc_B[ch] = NTC_B_COEFF;
+            _ntc_C[ch] = NTC_C_COEFF;
+            _heatFluxCal[ch].So = HFS_DEFAULT_SENSITIVITY;
+            _heatFluxCal[ch].Sc = HFS_DEFAULT_TEMP_COEFF;
+            _heatFluxCal[ch].To = HFS_DEFAULT_CALIB_TEMP;
+            _heatFluxCal[ch].sensorArea = HFS_DEFAULT_SENSOR_AREA;
+        }
+    }
+
+    // ===== INICIALIZACIÓN =====
+    /**
+     * @brief Inicializa el ADS1220 con la configuración fija
+     * @return true si la verificación de REG0 coincide
+     */
+    bool begin(SPIClass *spiInstance = &SPI) {
+        _transport.setSPI(spiInstance);
+        if (!_transport.begin()) {
+            return false;
+        }
+        if (USE_DRDY) {
+            pinMode(DRDY_PIN, INPUT);
+        }
+        delay(100);
+
+        _sendCommand(ADS1220_CMD_RESET);
+        delay(1);
+
+        _writeRegisters(FIRST_CHANNEL);
+        delayMicroseconds(300);
+
+        uint8_t readback[2] = {(uint8_t)(ADS1220_CMD_RREG | (ADS1220_REG0 << 2)), 0x00};
+        _transport.transfer(readback, readback, 2);
+        if (readback[1] != reg0(FIRST_CHANNEL)) {
+            return false;
+        }
+
+        _sendCommand(ADS1220_CMD_START_SYNC);
+        return true;
+    }
+
+    // ===== CALIBRACIÓN (en tiempo de ejecución) =====
+    void setNTCCoefficients(ADS1220_Channel channel, float A, float B, float C) {
+        _ntc_A[channel] = A;
+        _ntc_B[channel] = B;
+        _ntc_C[channel] = C;
+    }
+
+    void setHeatFluxCalibration(ADS1220_Channel channel, float So, float Sc, float To, float sensorArea) {
+        _heatFluxCal[channel].So = So;
+        _heatFluxCal[channel].Sc = Sc;
+        _heatFluxCal[channel].To = To;
+        _heatFluxCal[channel].sensorArea = sensorArea;
+    }
+
+    // ===== LECTURA =====
+    /**
+     * @brief Lee el código de 24 bits del canal CH
+     * @return Código con signo (0 si no hubo datos a tiempo)
+     */
+    template <ADS1220_Channel CH>
+    int32_t readRaw() {
+        static_assert(CHANNELS & (1 << CH), "Canal no habilitado en CHANNELS");
+
+        if (!SINGLE_CHANNEL) {
+            // Cambio de canal: configuración completa y asentamiento de IDAC/filtros
+            _writeRegisters(CH);
+            delay(ADS1220_DEFAULT_SETTLE_US / 1000);
+        }
+
+        // Con un solo canal y DRDY, el modo continuo ya entrega datos frescos
+        if (!(SINGLE_CHANNEL && USE_DRDY)) {
+            _sendCommand(ADS1220_CMD_START_SYNC);
+        }
+        if (!_waitForData()) {
+            return 0;
+        }
+
+        uint8_t buffer[4] = {ADS1220_CMD_RDATA, 0x00, 0x00, 0x00};
+        _transport.transfer(buffer, buffer, 4);
+
+        int32_t result = ((uint32_t)buffer[1] << 16) | ((uint32_t)buffer[2] << 8) | (uint32_t)buffer[3];
+        if (result & 0x00800000) {
+            result |= 0xFF000000;
+        }
+        return result;
+    }
+
+    template <ADS1220_Channel CH>
+    float readVoltage() {
+        return (float)readRaw<CH>() * VOLTS_PER_CODE;
+    }
+
+    template <ADS1220_Channel CH>
+    float readResistance() {
+        static_assert((CH == CHANNEL_0 ? MODE0 : MODE1) == MODE_NTC, "readResistance requiere MODE_NTC");
+        static_assert(IDAC_UA != 0, "readResistance requiere IDAC_UA > 0");
+        int32_t raw = readRaw<CH>();
+        return (raw > 0) ? (float)raw * OHMS_PER_CODE : 0.0f;
+    }
+
+    /**
+     * @brief Temperatura del NTC del canal CH [°C] (Steinhart-Hart)
+     */
+    template <ADS1220_Channel CH>
+    float readTemperature() {
+        float resistance = readResistance<CH>();
+        if (resistance <= 0.0f) {
+            return -999.0f;
+        }
+
+        float lnR = log(resistance);
+        float invT = _ntc_A[CH] + (_ntc_B[CH] * lnR) + (_ntc_C[CH] * lnR * lnR * lnR);
+        return 1.0f / invT - 273.15f;
+    }
+
+    /**
+     * @brief Flujo térmico del canal CH [W/m²] con sensibilidad corregida
+     * @param sensorTemp Temperatura del sensor [°C]
+     */
+    template <ADS1220_Channel CH>
+    float readHeatFlux(float sensorTemp) {
+        static_assert((CH == CHANNEL_0 ? MODE0 : MODE1) == MODE_HEAT_FLUX, "readHeatFlux requiere MODE_HEAT_FLUX");
+        float voltage_uV = readVoltage<CH>() * 1e6f;
+        float S = _heatFluxCal[CH].So + (sensorTemp - _heatFluxCal[CH].To) * _heatFluxCal[CH].Sc;
+        return voltage_uV / S;
+    }
+
+private:
+    ADS1220_SPITransport _transport;
+    float _ntc_A[2], _ntc_B[2], _ntc_C[2];
+    HeatFluxCalibration _heatFluxCal[2];
+
+    void _sendCommand(uint8_t cmd) {
+        _transport.transfer(&cmd, nullptr, 1);
+    }
+
+    void _writeRegisters(uint8_t ch) {
+        // REG0..REG3 en una ráfaga; todos los bytes son constantes de compilación
+        const uint8_t buffer[5] = {
+            (uint8_t)(ADS1220_CMD_WREG | (ADS1220_REG0 << 2) | 3),
+            reg0(ch), REG1, reg2(ch), REG3
+        };
+        _transport.transfer(buffer, nullptr, 5);
+    }
+
+    bool _waitForData() {
+        if (USE_DRDY) {
+            uint32_t startTime = millis();
+            while (digitalRead(DRDY_PIN) == HIGH) {
+                if (millis() - startTime > 2000) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // delayMicroseconds() solo es exacto hasta ~16 ms en AVR
+        if (WAIT_US > 16000) {
+            delay(WAIT_US / 1000 + 1);
+        } else {
+            delayMicroseconds(WAIT_US);
+        }
+        return true;
+    }
+};
+
+#endif // ADS1220_FIXED_H
@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Transporte emulado para pruebas en host
+ ******************************************************************************/
+
+#include "ADS1220_MockTransport.h"
+
+// Comandos del ADS1220 (mismos valores que ADS1220_CMD_* del driver)
+#define MOCK_CMD_POWERDOWN      0x02
+#define MOCK_CMD_RESET          0x06
+#define MOCK_CMD_START_SYNC     0x08
+#define MOCK_CMD_RDATA          0x10
+#define MOCK_CMD_RREG           0x20
+#define MOCK_CMD_WREG           0x40
+#define MOCK_REG1_CONTINUOUS    0x04
+
+ADS1220_MockTransport::ADS1220_MockTransport() {
+    for (uint8_t i = 0; i < 4; i++) {
+        _registers[i] = 0x00;
+    }
+    _code = 0;
+    _converter = nullptr;
+    _context = nullptr;
+    _started = false;
+    _ready = false;
+    _state = MOCK_COMMAND;
+    _regIndex = 0;
+    _remaining = 0;
+    _dataCode = 0;
+    _lastCommand = 0;
+    resetCounters();
+}
+
+void ADS1220_MockTransport::resetCounters() {
+    _transactions = 0;
+    _bytes = 0;
+    _conversions = 0;
+}
+
+void ADS1220_MockTransport::setConversionCode(int32_t code) {
+    _code = code;
+}
+
+void ADS1220_MockTransport::setConverter(ADS1220_MockConverter converter, void* context) {
+    _converter = converter;
+    _context = context;
+}
+
+bool ADS1220_MockTransport::dataReady() {
+    if (!_started) {
+        return false;
+    }
+    // Modo continuo: siempre hay una conversión nueva disponible
+    return _ready || (_registers[1] & MOCK_REG1_CONTINUOUS);
+}
+
+void ADS1220_MockTransport::transfer(const uint8_t* tx, uint8_t* rx, uint8_t length) {
+    // CS bajo: el intérprete de comandos vuelve a su estado inicial
+    _state = MOCK_COMMAND;
+    _transactions++;
+
+    for (uint8_t i = 0; i < length; i++) {
+        uint8_t in = (tx != nullptr) ? tx[i] : 0x00;
+        uint8_t out = _exchange(in);
+        if (rx != nullptr) {
+            rx[i] = out;
+        }
+    }
+    _bytes += length;
+}
+
+// =============================================================================
+// FUNCIONES PRIVADAS
+// =============================================================================
+
+uint8_t ADS1220_MockTransport::_exchange(uint8_t byte) {
+    switch (_state) {
+        case MOCK_READ_REGISTERS:
+            {
+                uint8_t value = _registers[_regIndex & 0x03];
+                _regIndex++;
+                if (--_remaining == 0) {
+                    _state = MOCK_COMMAND;
+                }
+                return value;
+            }
+
+        case MOCK_WRITE_REGISTERS:
+            _registers[_regIndex & 0x03] = byte;
+            _regIndex++;
+            if (--_remaining == 0) {
+                _state = MOCK_COMMAND;
+            }
+            return 0x00;
+
+        case MOCK_READ_DATA:
+            {
+                uint8_t value = (uint8_t)(((uint32_t)_dataCode >> (8 * (_remaining - 1))) & 0xFF);
+                if (--_remaining == 0) {
+                    _state = MOCK_COMMAND;
+                }
+                return value;
+            }
+
+        case MOCK_COMMAND:
+        default:
+            break;
+    }
+
+    _lastCommand = byte;
+
+    if ((byte & 0xF0) == MOCK_CMD_RREG) {
+        _regIndex = (byte >> 2) & 0x03;
+        _remaining = (byte & 0x03) + 1;
+        _state = MOCK_READ_REGISTERS;
+    } else if ((byte & 0xF0) == MOCK_CMD_WREG) {
+        _regIndex = (byte >> 2) & 0x03;
+        _remaining = (byte & 0x03) + 1;
+        _state = MOCK_WRITE_REGISTERS;
+    } else if ((byte & 0xFE) == MOCK_CMD_RDATA) {
+        _dataCode = _convert();
+        _remaining = 3;
+        _state = MOCK_READ_DATA;
+        _ready = false;
+    } else if ((byte & 0xFE) == MOCK_CMD_START_SYNC) {
+        _started = true;
+        _ready = true;
+    } else if ((byte & 0xFE) == MOCK_CMD_RESET) {
+        for (uint8_t i = 0; i < 4; i++) {
+            _registers[i] = 0x00;
+        }
+        _started = false;
+        _ready = false;
+    } else if ((byte & 0xFE) == MOCK_CMD_POWERDOWN) {
+        _started = false;
+        _ready = false;
+    }
+    return 0x00;
+}
+
+int32_t ADS1220_MockTransport::_convert() {
+    _conversions++;
+    int32_t code = (_converter != nullptr) ? _converter(_registers, _context) : _code;
+
+    // Saturar al rango de 24 bits como el ADC
+    if (code > 0x7FFFFF) code = 0x7FFFFF;
+    if (code < -0x800000) code = -0x800000;
+    return code;
+}
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Transporte emulado para pruebas en host
+ *
+ * Emula el juego de comandos del ADS1220 (RESET, START/SYNC, POWERDOWN,
+ * RDATA, RREG y WREG con ráfagas de 1 a 4 registros) sobre un banco de
+ * registros en memoria. El código de cada conversión lo da un valor fijo o
+ * una función que recibe los registros vigentes, de modo que una prueba puede
+ * devolver códigos distintos según MUX, ganancia o enrutamiento IDAC.
+ *
+ * DRDY se emula: el dato queda listo tras START/SYNC (o en modo continuo,
+ * siempre) y se consume con RDATA.
+ *
+ * Este archivo no depende de Arduino.
+ ******************************************************************************/
+
+#ifndef ADS1220_MOCK_TRANSPORT_H
+#define ADS1220_MOCK_TRANSPORT_H
+
+#include "ADS1220_Transport.h"
+
+/**
+ * @brief Genera el código de 24 bits de una conversión
+ * @param registers Registros REG0..REG3 vigentes
+ * @param context Puntero de usuario pasado a setConverter()
+ */
+typedef int32_t (*ADS1220_MockConverter)(const uint8_t* registers, void* context);
+
+class ADS1220_MockTransport : public ADS1220_Transport {
+public:
+    ADS1220_MockTransport();
+
+    void transfer(const uint8_t* tx, uint8_t* rx, uint8_t length) override;
+    bool hasDataReady() override { return true; }
+    bool dataReady() override;
+
+    // ===== ESTÍMULO =====
+    void setConversionCode(int32_t code);
+    void setConverter(ADS1220_MockConverter converter, void* context = nullptr);
+
+    // ===== INSPECCIÓN =====
+    uint8_t getRegister(uint8_t reg) const { return _registers[reg & 0x03]; }
+    void setRegister(uint8_t reg, uint8_t value) { _registers[reg & 0x03] = value; }
+    uint32_t transactionCount() const { return _transactions; }
+    uint32_t byteCount() const { return _bytes; }
+    uint32_t conversionCount() const { return _conversions; }
+    uint8_t lastCommand() const { return _lastCommand; }
+    void resetCounters();
+
+private:
+    enum State : uint8_t {
+        MOCK_COMMAND,
+        MOCK_READ_REGISTERS,
+        MOCK_WRITE_REGISTERS,
+        MOCK_READ_DATA
+    };
+
+    uint8_t _registers[4];
+    int32_t _code;
+    ADS1220_MockConverter _converter;
+    void* _context;
+    bool _started;
+    bool _ready;
+
+    State _state;
+    uint8_t _regIndex;
+    uint8_t _remaining;
+    int32_t _dataCode;
+
+    uint32_t _transactions;
+    uint32_t _bytes;
+    uint32_t _conversions;
+    uint8_t _lastCommand;
+
+    uint8_t _exchange(uint8_t byte);
+    int32_t _convert();
+};
+
+#endif // ADS1220_MOCK_TRANSPORT_H
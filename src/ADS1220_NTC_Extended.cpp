@@ -9,14 +9,33 @@
 
 #include "ADS1220_NTC_Extended.h"
 
+#if defined(__AVR__)
+#include <EEPROM.h>
+#elif defined(ESP32)
+#include <Preferences.h>
+#endif
+
+// Sección crítica de snapshots (energía, estadísticas): en ESP32 la adquisición
+// puede correr en otra tarea/núcleo (ADS1220_AsyncESP32); en AVR todo corre en
+// el mismo contexto y no hace falta bloquear
+#if defined(ESP32)
+static portMUX_TYPE s_snapshotMux = portMUX_INITIALIZER_UNLOCKED;
+#define ADS1220_SNAPSHOT_LOCK()     portENTER_CRITICAL(&s_snapshotMux)
+#define ADS1220_SNAPSHOT_UNLOCK()   portEXIT_CRITICAL(&s_snapshotMux)
+#else
+#define ADS1220_SNAPSHOT_LOCK()
+#define ADS1220_SNAPSHOT_UNLOCK()
+#endif
+
 // =============================================================================
 // CONSTRUCTORES
 // =============================================================================
 
-ADS1220_NTC_Extended::ADS1220_NTC_Extended(uint8_t csPin, uint8_t drdyPin) {
-    _csPin = csPin;
+ADS1220_NTC_Extended::ADS1220_NTC_Extended(uint8_t csPin, uint8_t drdyPin)
+    : _defaultTransport(csPin) {
     _drdyPin = drdyPin;
-    _spi = nullptr;
+    _transport = nullptr;
+    _warmStart = false;
     
     // Inicializar registros
     _reg0 = 0x00;
@@ -26,47 +45,175 @@ ADS1220_NTC_Extended::ADS1220_NTC_Extended(uint8_t csPin, uint8_t drdyPin) {
     
     // Inicializar coeficientes NTC con valores por defecto
     for (int ch = 0; ch < 2; ch++) {
-        _ntc_A[ch] = NTC_A_COEFF;
-        _ntc_B[ch] = NTC_B_COEFF;
-        _ntc_C[ch] = NTC_C_COEFF;
+        _ntc_A[_cal(ch)] = NTC_A_COEFF;
+        _ntc_B[_cal(ch)] = NTC_B_COEFF;
+        _ntc_C[_cal(ch)] = NTC_C_COEFF;
     }
     
     // Inicializar calibración de flujo térmico con valores por defecto
     for (int ch = 0; ch < 2; ch++) {
-        _heatFluxCal[ch].So = HFS_DEFAULT_SENSITIVITY;
-        _heatFluxCal[ch].Sc = HFS_DEFAULT_TEMP_COEFF;
-        _heatFluxCal[ch].To = HFS_DEFAULT_CALIB_TEMP;
-        _heatFluxCal[ch].sensorArea = HFS_DEFAULT_SENSOR_AREA;
+        _heatFluxCal[_cal(ch)].So = HFS_DEFAULT_SENSITIVITY;
+        _heatFluxCal[_cal(ch)].Sc = HFS_DEFAULT_TEMP_COEFF;
+        _heatFluxCal[_cal(ch)].To = HFS_DEFAULT_CALIB_TEMP;
+        _heatFluxCal[_cal(ch)].sensorArea = HFS_DEFAULT_SENSOR_AREA;
+        _hfSensorTemp[ch] = HFS_DEFAULT_CALIB_TEMP;
     }
     
     // Modo por defecto: NTC
     _channelMode[0] = MODE_NTC;
     _channelMode[1] = MODE_NTC;
+    _chopEnabled[0] = false;
+    _chopEnabled[1] = false;
+    
+    // Modelo directo T(code) deshabilitado hasta setDirectTemperatureModel()
+    for (int ch = 0; ch < 2; ch++) {
+        _modelEnabled[ch] = false;
+        _modelFirstOctave[ch] = 0;
+        _modelSubBits[ch] = 0;
+        _modelSegments[ch] = 0;
+        _modelMinTemp[ch] = -40.0f;
+        _modelMaxTemp[ch] = 125.0f;
+    }
+    _modelDirty = 0x03;
     
     // Corriente IDAC por defecto
     _idacCurrent = ADS1220_IDAC_CURRENT;
     
+    // Referencia interna por defecto (sin medición ratiométrica)
+    for (int ch = 0; ch < 2; ch++) {
+        _refResistance[ch] = 0.0f;
+        _ratioScale[ch] = 0.0f;
+    }
+    
     // Ganancia por defecto
     _currentGain = 1;
     
-    // Inicializar moving average
-    _avgSize = 5;
-    for (int ch = 0; ch < 2; ch++) {
-        _bufferIndex[ch] = 0;
-        _bufferFull[ch] = false;
-        for (int i = 0; i < MAX_AVG_SIZE; i++) {
-            _tempBuffer[ch][i] = 0.0f;
-        }
+    // Tabla de offsets vacía (se llena con calibrateOffset())
+    for (int i = 0; i < 8; i++) {
+        _offsetTable[i] = 0;
     }
+    _offsetValid = 0;
+    _offsetCorrection = true;
+    _offsetRefreshInterval = 0;
+    _conversionsSinceRefresh = 0;
+    
+    // Inicializar moving average (buffer interno si se compiló con él)
+    _filterBuffer = nullptr;
+    _filterCapacity = 0;
+    _filterExternal = false;
+    _avgSize = 5;
+    setFilterStorage(nullptr, 0);
     
     // Variables de debug
     _lastRawReading = 0;
+    _lastChannel = CHANNEL_0;
+#if ADS1220_DEBUG_STATE
     _lastVoltage = 0.0f;
     _lastResistance = 0.0f;
     _lastTemperature = 0.0f;
     _lastHeatFlux = 0.0f;
     _lastThermalPower = 0.0f;
-    _lastChannel = CHANNEL_0;
+#endif
+    
+    // Lectura no bloqueante
+    _readState = STATE_IDLE;
+    _readPhase = PHASE_MAIN;
+    _readChannel = CHANNEL_0;
+    _readStart_us = 0;
+    _phaseStart_us = 0;
+    _settleTime_us = ADS1220_DEFAULT_SETTLE_US;
+    _chopCode = 0;
+    
+    // Vigilancia de registros deshabilitada hasta setRegisterWatchdog()
+    _watchdogInterval = 0;
+    _watchdogCount = 0;
+    _registerChecks = 0;
+    _registerFaults = 0;
+    
+    // Diagnóstico por burnout deshabilitado hasta setSensorDiagnostics();
+    // la comprobación de rango de cada muestra siempre está activa
+    for (int ch = 0; ch < 2; ch++) {
+        _rangeHealth[ch] = HEALTH_UNKNOWN;
+    }
+#if ADS1220_SENSOR_DIAGNOSTICS
+    _diagInterval = 0;
+    _diagSaturated = 0;
+    for (int ch = 0; ch < 2; ch++) {
+        _diagCount[ch] = 0;
+        _diagHealth[ch] = HEALTH_UNKNOWN;
+        _diagResistance[ch] = 0.0f;
+        _diagMinOhms[ch] = ADS1220_DIAG_SHORT_OHMS;
+        _diagMaxOhms[ch] = 0.0f;
+        _diagSignal[ch] = 0.0f;
+    }
+#endif
+    
+    // Registro de muestras
+    _sampleHead = 0;
+    _sampleCount = 0;
+    _frameSequence = 0;
+    _sampleTotal = 0;
+    
+    // Flujos diezmados deshabilitados hasta setDecimatedRate()
+#if ADS1220_DECIMATION
+    for (int ch = 0; ch < 2; ch++) {
+        _decimator[ch].period_us = 0;
+        _decimator[ch].count = 0;
+        _decimator[ch].head = 0;
+        _decimator[ch].pending = 0;
+    }
+#endif
+    
+    // Informe por eventos deshabilitado hasta setEventReporting()
+#if ADS1220_EVENT_REPORTING
+    for (int ch = 0; ch < 2; ch++) {
+        _events[ch].enabled = false;
+        _events[ch].primed = false;
+        _events[ch].suppressed = 0;
+    }
+    _eventCallback = nullptr;
+    _eventContext = nullptr;
+    _eventHead = 0;
+    _eventCount = 0;
+#endif
+    
+    // Acumuladores de energía deshabilitados hasta enableEnergyAccumulator()
+#if ADS1220_ENERGY_ACCUMULATOR
+    for (int ch = 0; ch < 2; ch++) {
+        _energy[ch].enabled = false;
+        _energy[ch].window_us = 1000000UL;
+        resetEnergyAccumulator(ch == 0 ? CHANNEL_0 : CHANNEL_1);
+    }
+#endif
+    
+    // Estadísticas y bloques periódicos deshabilitados hasta enableStatistics()
+#if ADS1220_STATISTICS
+    for (int ch = 0; ch < 2; ch++) {
+        _stats[ch].enabled = false;
+        _statsInterval_us[ch] = 0;
+        _statsBlockReady[ch] = false;
+        resetStatistics(ch == 0 ? CHANNEL_0 : CHANNEL_1);
+    }
+#endif
+    
+    // Etapa por muestra (compensadores deshabilitados por su constructor)
+    for (int ch = 0; ch < 2; ch++) {
+        _stageValue[ch] = 0.0f;
+        _stageLast_us[ch] = 0;
+    }
+    
+    // Control PID sin configurar hasta beginPeltierControl()
+#if ADS1220_PELTIER_CONTROL
+    _controlEnabled = false;
+    _controlChannel = CHANNEL_0;
+    _pwmPin = 255;
+    _dirPin = 255;
+    _pwmMax = 0;
+    _controlLatency_us = 0;
+    _controlMaxLatency_us = 0;
+    _controlUpdates = 0;
+#endif
+    _replaying = false;
 }
 
 ADS1220_NTC_Extended::ADS1220_NTC_Extended(uint8_t csPin, uint8_t drdyPin, float idacCurrent_uA) 
@@ -84,16 +231,21 @@ ADS1220_NTC_Extended::ADS1220_NTC_Extended(uint8_t csPin, uint8_t drdyPin, float
 // =============================================================================
 
 bool ADS1220_NTC_Extended::begin(SPIClass *spiInstance) {
-    _spi = spiInstance;
-    
-    pinMode(_csPin, OUTPUT);
-    csHigh();
+    _defaultTransport.setSPI(spiInstance);
+    return begin(&_defaultTransport);
+}
+
+bool ADS1220_NTC_Extended::begin(ADS1220_Transport *transport) {
+    _transport = transport;
     
     if (_drdyPin != 255) {
         pinMode(_drdyPin, INPUT);
     }
     
-    _spi->begin();
+    if (!_transport->begin()) {
+        _transport = nullptr;
+        return false;
+    }
     delay(100);
     
     reset();
@@ -120,6 +272,7 @@ bool ADS1220_NTC_Extended::begin(SPIClass *spiInstance) {
         case 7: _currentGain = 128; break;
         default: _currentGain = 1; break;
     }
+    _updateRatiometricScale();
     
     _reg1 = ADS1220_DR_90SPS | ADS1220_MODE_NORMAL | ADS1220_CM_CONTINUOUS;
     writeRegister(ADS1220_REG1, _reg1);
@@ -146,6 +299,59 @@ bool ADS1220_NTC_Extended::begin(SPIClass *spiInstance) {
     return true;
 }
 
+bool ADS1220_NTC_Extended::beginWarm(SPIClass *spiInstance, uint16_t slot) {
+    _defaultTransport.setSPI(spiInstance);
+    return beginWarm(&_defaultTransport, slot);
+}
+
+bool ADS1220_NTC_Extended::beginWarm(ADS1220_Transport *transport, uint16_t slot) {
+    _warmStart = false;
+    
+    if (!loadConfiguration(slot)) {
+        return begin(transport);  // Sin configuración guardada: arranque completo
+    }
+    
+    _transport = transport;
+    
+    if (_drdyPin != 255) {
+        pinMode(_drdyPin, INPUT);
+    }
+    
+    if (!_transport->begin()) {
+        _transport = nullptr;
+        return false;
+    }
+    
+    // Estado del ADC en una sola ráfaga RREG
+    uint8_t chip[4];
+    readRegisters(ADS1220_REG0, 4, chip);
+    
+    // MUX, VREF e IDAC dependen del último canal leído: se comparan ganancia y
+    // PGA, REG1 completo y el filtro 50/60 Hz. Todo 0xFF = MISO sin ADC.
+    bool blank = (chip[0] & chip[1] & chip[2] & chip[3]) == 0xFF;
+    if (!blank &&
+        (chip[0] & 0x0F) == (_reg0 & 0x0F) &&
+        chip[1] == _reg1 &&
+        (chip[2] & 0x30) == (_reg2 & 0x30)) {
+        // El ADC conservó la configuración: sin RESET ni escrituras
+        _reg0 = chip[0];
+        _reg2 = chip[2];
+        _reg3 = chip[3];
+        _warmStart = true;
+    } else {
+        // ADC recién alimentado o con otra configuración: RESET y ráfaga WREG
+        reset();
+        writeRegisters(ADS1220_REG0, 4);
+        readRegisters(ADS1220_REG0, 4, chip);
+        if (chip[0] != _reg0 || chip[1] != _reg1 || chip[2] != _reg2 || chip[3] != _reg3) {
+            return false;
+        }
+    }
+    
+    startConversion();
+    return true;
+}
+
 // =============================================================================
 // CONFIGURACIÓN DE MODO
 // =============================================================================
@@ -191,15 +397,17 @@ ADS1220_SensorMode ADS1220_NTC_Extended::getChannelMode(ADS1220_Channel channel)
 
 void ADS1220_NTC_Extended::setNTCCoefficients(ADS1220_Channel channel, float A, float B, float C) {
     uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
-    _ntc_A[ch] = A;
-    _ntc_B[ch] = B;
-    _ntc_C[ch] = C;
+    _ntc_A[_cal(ch)] = A;
+    _ntc_B[_cal(ch)] = B;
+    _ntc_C[_cal(ch)] = C;
+    _modelDirty |= (1 << ch);
 }
 
 void ADS1220_NTC_Extended::setIDACCurrent(float idacCurrent_uA) {
     _idacCurrent = idacCurrent_uA * 1e-6f;
+    _modelDirty = 0x03;
     
-    if (_spi != nullptr) {
+    if (_transport != nullptr) {
         uint8_t idac_setting = _getCurrentRegisterSetting(idacCurrent_uA);
         _reg2 = (_reg2 & 0xF8) | idac_setting;
         writeRegister(ADS1220_REG2, _reg2);
@@ -208,10 +416,11 @@ void ADS1220_NTC_Extended::setIDACCurrent(float idacCurrent_uA) {
 
 void ADS1220_NTC_Extended::setMeasuredIDACCurrent(float measuredCurrent_uA) {
     _idacCurrent = measuredCurrent_uA * 1e-6f;
+    _modelDirty = 0x03;
 }
 
 void ADS1220_NTC_Extended::setMovingAverageSize(uint8_t size) {
-    if (size > MAX_AVG_SIZE) size = MAX_AVG_SIZE;
+    if (size > _filterCapacity) size = _filterCapacity;
     if (size < 1) size = 1;
     _avgSize = size;
     
@@ -221,140 +430,465 @@ void ADS1220_NTC_Extended::setMovingAverageSize(uint8_t size) {
     }
 }
 
+void ADS1220_NTC_Extended::setFilterStorage(float* storage, uint8_t size) {
+    if (storage != nullptr && size > 0) {
+        _filterBuffer = storage;
+        _filterCapacity = size;
+        _filterExternal = true;
+    } else {
+#if ADS1220_MAX_AVG_SIZE > 0
+        _filterBuffer = &_tempBuffer[0][0];
+        _filterCapacity = ADS1220_MAX_AVG_SIZE;
+#else
+        _filterBuffer = nullptr;
+        _filterCapacity = 0;
+#endif
+        _filterExternal = false;
+    }
+    
+    for (uint16_t i = 0; i < 2 * (uint16_t)_filterCapacity; i++) {
+        _filterBuffer[i] = 0.0f;
+    }
+    setMovingAverageSize(_avgSize);
+}
+
+void ADS1220_NTC_Extended::setChopMode(ADS1220_Channel channel, bool enable) {
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    _chopEnabled[ch] = enable;
+}
+
+bool ADS1220_NTC_Extended::getChopMode(ADS1220_Channel channel) {
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    return _chopEnabled[ch];
+}
+
+void ADS1220_NTC_Extended::setReferenceResistor(ADS1220_Channel channel, float referenceResistance) {
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    _refResistance[ch] = (referenceResistance > 0.0f) ? referenceResistance : 0.0f;
+    _updateRatiometricScale();
+}
+
+float ADS1220_NTC_Extended::getReferenceResistor(ADS1220_Channel channel) {
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    return _refResistance[ch];
+}
+
 // =============================================================================
 // CONFIGURACIÓN HEAT FLUX
 // =============================================================================
 
 void ADS1220_NTC_Extended::setHeatFluxCalibration(ADS1220_Channel channel, float So, float Sc, float To, float sensorArea) {
     uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
-    _heatFluxCal[ch].So = So;
-    _heatFluxCal[ch].Sc = Sc;
-    _heatFluxCal[ch].To = To;
-    _heatFluxCal[ch].sensorArea = sensorArea;
+    _heatFluxCal[_cal(ch)].So = So;
+    _heatFluxCal[_cal(ch)].Sc = Sc;
+    _heatFluxCal[_cal(ch)].To = To;
+    _heatFluxCal[_cal(ch)].sensorArea = sensorArea;
 }
 
 void ADS1220_NTC_Extended::setHeatFluxSensitivity(ADS1220_Channel channel, float So) {
     uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
-    _heatFluxCal[ch].So = So;
+    _heatFluxCal[_cal(ch)].So = So;
 }
 
 HeatFluxCalibration ADS1220_NTC_Extended::getHeatFluxCalibration(ADS1220_Channel channel) {
     uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
-    return _heatFluxCal[ch];
+    return _heatFluxCal[_cal(ch)];
 }
 
 // =============================================================================
-// LECTURA NTC
+// LECTURA NO BLOQUEANTE
 // =============================================================================
 
-int32_t ADS1220_NTC_Extended::readRaw(ADS1220_Channel channel) {
-    configureChannel(channel);
-    configureIDAC(channel);
+bool ADS1220_NTC_Extended::startRead(ADS1220_Channel channel) {
+    if (_readState != STATE_IDLE) {
+        return false;
+    }
     
-    if (!waitForData(2000)) {
-        return 0;
+    _readChannel = channel;
+    _readStart_us = micros();
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    ReadPhase phase = PHASE_MAIN;
+    
+#if ADS1220_SENSOR_DIAGNOSTICS
+    // Diagnóstico intercalado: una conversión con las fuentes de burnout cada
+    // _diagInterval lecturas del canal, antes de la conversión del canal
+    if (_diagInterval != 0 && ++_diagCount[ch] >= _diagInterval) {
+        _diagCount[ch] = 0;
+        phase = PHASE_DIAG;
+    }
+#else
+    (void)ch;
+#endif
+    
+    // Recalibración de offset intercalada: una conversión en corto cada
+    // _offsetRefreshInterval lecturas (si coincide con un diagnóstico, pasa
+    // a la lectura siguiente)
+    if (_offsetRefreshInterval != 0 && ++_conversionsSinceRefresh >= _offsetRefreshInterval &&
+        phase == PHASE_MAIN) {
+        _conversionsSinceRefresh = 0;
+        phase = PHASE_OFFSET;
+    }
+    
+    _beginPhase(phase);
+    return true;
+}
+
+ADS1220_ReadStatus ADS1220_NTC_Extended::poll(ADS1220_Sample &sample) {
+    if (_readState == STATE_IDLE) {
+        return READ_IDLE;
     }
     
-    int32_t rawValue = readConversionData();
+    uint32_t now = micros();
+    if (now - _readStart_us > ADS1220_READ_TIMEOUT_US) {
+        cancelRead();
+        return READ_TIMEOUT;
+    }
     
-    _lastRawReading = rawValue;
-    _lastChannel = channel;
+    if (_readState == STATE_SETTLING) {
+        if (now - _phaseStart_us < _settleTime_us) {
+            return READ_PENDING;
+        }
+        // START/SYNC reinicia el filtro digital: el primer dato ya está asentado
+        startConversion();
+        _phaseStart_us = now;
+        _readState = STATE_CONVERTING;
+        return READ_PENDING;
+    }
     
-    return rawValue;
+    if (!_conversionReady(now)) {
+        return READ_PENDING;
+    }
+    
+    // now: primer poll() que ve el dato listo, antes de RDATA y del cálculo;
+    // es el timestamp de la muestra y el origen de la latencia de control
+    int32_t code = readConversionData();
+    uint8_t ch = (_readChannel == CHANNEL_0) ? 0 : 1;
+    
+    switch (_readPhase) {
+        case PHASE_OFFSET:
+            _updateBackgroundOffset(code);
+            _beginPhase(PHASE_MAIN);
+            return READ_PENDING;
+            
+        case PHASE_DIAG:
+#if ADS1220_SENSOR_DIAGNOSTICS
+            _evaluateDiagnostic(ch, code);
+#endif
+            _beginPhase(PHASE_MAIN);
+            return READ_PENDING;
+            
+        case PHASE_MAIN:
+            if (_chopEnabled[ch] && _channelMode[ch] == MODE_NTC) {
+                _chopCode = code;
+                _beginPhase(PHASE_CHOP_B);
+                return READ_PENDING;
+            }
+            {
+                uint8_t flags = _offsetFlag();
+                if (_watchdogDue() && !_verifyRegisters(_reg3)) {
+                    flags |= ADS1220_SAMPLE_CONFIG_FAULT;
+                }
+                _finishRead(_applyOffset(code), flags, now, sample);
+            }
+            return READ_READY;
+            
+        case PHASE_CHOP_B:
+        default:
+            {
+                // La fase B convirtió con las fuentes IDAC intercambiadas
+                uint8_t flags = ADS1220_SAMPLE_CHOPPED;
+                if (_watchdogDue() && !_verifyRegisters(_chopReg3())) {
+                    flags |= ADS1220_SAMPLE_CONFIG_FAULT;
+                }
+                
+                // Restaurar el enrutamiento normal de IDAC para el otro canal
+                writeRegister(ADS1220_REG3, _reg3);
+                
+                // A = +V + Vos, B = -V + Vos  ->  (A - B) / 2 = V
+                int32_t diff = _chopCode - code;
+                int32_t rawValue = (diff >= 0) ? (diff + 1) / 2 : (diff - 1) / 2;
+                _finishRead(rawValue, flags, now, sample);
+            }
+            return READ_READY;
+    }
+}
+
+bool ADS1220_NTC_Extended::isReadBusy() {
+    return _readState != STATE_IDLE;
+}
+
+void ADS1220_NTC_Extended::cancelRead() {
+    if (_readState != STATE_IDLE && _readPhase == PHASE_CHOP_B) {
+        writeRegister(ADS1220_REG3, _reg3);
+    } else if (_readState != STATE_IDLE && _readPhase == PHASE_DIAG) {
+        // El diagnóstico escribió el chip sin tocar los shadow (BCS, ganancia
+        // 1, bypass, IDAC apagado): restaurar los cuatro registros
+        writeRegisters(ADS1220_REG0, 4);
+    }
+    _readState = STATE_IDLE;
+}
+
+ADS1220_BusRequest ADS1220_NTC_Extended::busRequest(uint32_t &wait_us) {
+    wait_us = 0;
+    if (_readState == STATE_IDLE) {
+        return BUS_NONE;
+    }
+    
+    uint32_t now = micros();
+    uint32_t elapsed = now - _phaseStart_us;
+    
+    if (_readState == STATE_SETTLING) {
+        if (elapsed < _settleTime_us) {
+            wait_us = _settleTime_us - elapsed;
+        }
+        return BUS_WRITE;
+    }
+    
+    if (!_conversionReady(now)) {
+        // Estimación por periodo nominal; si DRDY se retrasa, revisar pronto
+        uint32_t period = _conversionTime_us();
+        bool hasReady = (_drdyPin != 255) || _transport->hasDataReady();
+        uint32_t due = hasReady ? period : period + period / 8 + 100;
+        wait_us = (elapsed < due) ? (due - elapsed) : 1;
+    }
+    return BUS_READ;
+}
+
+void ADS1220_NTC_Extended::setSettlingTime(uint32_t settleTime_us) {
+    _settleTime_us = settleTime_us;
+}
+
+void ADS1220_NTC_Extended::setHeatFluxSensorTemperature(ADS1220_Channel channel, float sensorTemp) {
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    _hfSensorTemp[ch] = sensorTemp;
+}
+
+// =============================================================================
+// LECTURA NTC
+// =============================================================================
+
+int32_t ADS1220_NTC_Extended::readRaw(ADS1220_Channel channel) {
+    ADS1220_Sample sample;
+    if (!_readBlocking(channel, sample)) {
+        return 0;
+    }
+    return sample.raw;
 }
 
 float ADS1220_NTC_Extended::readVoltage(ADS1220_Channel channel) {
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
     int32_t raw = readRaw(channel);
-    float voltage = rawToVoltage(raw);
+    
+    float voltage;
+    if (_refResistance[ch] > 0.0f) {
+        // En modo ratiométrico VREF = I × R_ref no es conocida: voltaje estimado
+        voltage = rawToResistance(ch, raw) * _idacCurrent;
+    } else {
+        voltage = rawToVoltage(raw);
+    }
+#if ADS1220_DEBUG_STATE
     _lastVoltage = voltage;
+#endif
     return voltage;
 }
 
 float ADS1220_NTC_Extended::readResistance(ADS1220_Channel channel) {
-    float voltage = readVoltage(channel);
-    float resistance = voltageToResistance(voltage);
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    
+    float resistance;
+    if (_refResistance[ch] > 0.0f) {
+        // Ratiométrico: una sola multiplicación, sin dividir entre la corriente
+        int32_t raw = readRaw(channel);
+        resistance = rawToResistance(ch, raw);
+#if ADS1220_DEBUG_STATE
+        _lastVoltage = resistance * _idacCurrent;
+#endif
+    } else {
+        float voltage = readVoltage(channel);
+        resistance = voltageToResistance(voltage);
+    }
+#if ADS1220_DEBUG_STATE
     _lastResistance = resistance;
+#endif
     return resistance;
 }
 
 float ADS1220_NTC_Extended::readTemperature(ADS1220_Channel channel) {
-    float resistance = readResistance(channel);
-    float temperature = resistanceToTemperature(resistance);
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    
+    ADS1220_Sample sample;
+    float temperature;
+    if (!_readBlocking(channel, sample)) {
+        temperature = -999.0f;
+    } else if (_channelMode[ch] == MODE_NTC && !(sample.flags & ADS1220_SAMPLE_VALUE_VALID)) {
+        temperature = -999.0f;  // Código saturado (NTC abierta), ver getChannelHealth()
+    } else if (_channelMode[ch] == MODE_NTC) {
+        // Calculada al completar la conversión (modelo directo o cadena completa)
+        temperature = sample.value;
+    } else {
+        // Canal en modo flujo: el registro conserva el valor en W/m² que ya
+        // consumieron energía, estadísticas y eventos; solo se devuelve la T
+        temperature = _chainTemperature(ch, sample.raw);
+    }
+    
+#if ADS1220_DEBUG_STATE
     _lastTemperature = temperature;
+#endif
     return temperature;
 }
 
 float ADS1220_NTC_Extended::readTemperatureFiltered(ADS1220_Channel channel) {
     float temp = readTemperature(channel);
+    if (temp == -999.0f) {
+        return temp;  // Lectura fallida o saturada: no entra en el filtro
+    }
+    if (_stageActive(channel)) {
+        return _stageValue[channel];  // _finishRead() ya pasó esta muestra por el filtro
+    }
     return updateMovingAverage(channel, temp);
 }
 
 // =============================================================================
-// LECTURA HEAT FLUX (NUEVO)
+// MODELO DIRECTO CÓDIGO -> TEMPERATURA
 // =============================================================================
 
-float ADS1220_NTC_Extended::readHeatFluxVoltage(ADS1220_Channel channel) {
-    configureChannel(channel);
-    
-    // Asegurar que IDAC esté OFF
+void ADS1220_NTC_Extended::setDirectTemperatureModel(ADS1220_Channel channel, bool enable,
+                                                     float minTemp, float maxTemp) {
     uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
-    if (_channelMode[ch] == MODE_HEAT_FLUX) {
-        _reg2 = (_reg2 & 0xF8) | ADS1220_IDAC_OFF;
-        writeRegister(ADS1220_REG2, _reg2);
+    if (maxTemp < minTemp) {
+        float tmp = minTemp;
+        minTemp = maxTemp;
+        maxTemp = tmp;
+    }
+    _modelEnabled[ch] = enable;
+    _modelMinTemp[ch] = minTemp;
+    _modelMaxTemp[ch] = maxTemp;
+    _modelDirty |= (1 << ch);
+}
+
+float ADS1220_NTC_Extended::verifyDirectModel(ADS1220_Channel channel, uint16_t points) {
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    if (!_modelEnabled[ch]) {
+        return -1.0f;
+    }
+    if (_modelDirty & (1 << ch)) {
+        _fitDirectModel(ch);
+    }
+    if (_modelSegments[ch] == 0 || points < 2) {
+        return -1.0f;
     }
     
-    if (!waitForData(2000)) {
-        return 0.0f;
+    // Códigos distribuidos geométricamente sobre las octavas cubiertas
+    uint8_t octaves = _modelSegments[ch] >> _modelSubBits[ch];
+    float firstCode = ldexp(1.0f, _modelFirstOctave[ch]);
+    float ratio = pow(2.0f, (float)octaves / (float)(points - 1));
+    
+    float maxError = 0.0f;
+    float code = firstCode;
+    for (uint16_t i = 0; i < points; i++) {
+        int32_t raw = (int32_t)code;
+        if (raw > ADS1220_MAX_CODE) raw = ADS1220_MAX_CODE;
+        
+        float modelTemp;
+        if (_evaluateDirectModel(ch, raw, modelTemp)) {
+            float error = fabs(modelTemp - _chainTemperature(ch, raw));
+            if (error > maxError) maxError = error;
+        }
+        code *= ratio;
+    }
+    return maxError;
+}
+
+// =============================================================================
+// LECTURA HEAT FLUX (NUEVO)
+// =============================================================================
+
+float ADS1220_NTC_Extended::readHeatFluxVoltage(ADS1220_Channel channel) {
+    float voltage_uV;
+    _readHeatFluxVoltage(channel, voltage_uV);
+    return voltage_uV;
+}
+
+bool ADS1220_NTC_Extended::_readHeatFluxVoltage(ADS1220_Channel channel, float &voltage_uV) {
+    // configureIDAC() deja IDAC OFF y referencia interna en modo Heat Flux
+    ADS1220_Sample sample;
+    if (!_readBlocking(channel, sample)) {
+        voltage_uV = 0.0f;
+        return false;
     }
     
-    int32_t rawValue = readConversionData();
-    float voltage = rawToVoltage(rawValue);
-    float voltage_uV = voltage * 1e6f;  // V → µV
+    float voltage = rawToVoltage(sample.raw);
+    voltage_uV = voltage * 1e6f;  // V → µV
     
-    _lastRawReading = rawValue;
+#if ADS1220_DEBUG_STATE
     _lastVoltage = voltage;
-    _lastChannel = channel;
+#endif
     
-    return voltage_uV;
+    return (sample.flags & ADS1220_SAMPLE_VALUE_VALID) != 0;
 }
 
 float ADS1220_NTC_Extended::getTemperatureCorrectedSensitivity(ADS1220_Channel channel, float sensorTemp) {
     uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
     
     // S = So + (Ts - To) * Sc
-    float deltaT = sensorTemp - _heatFluxCal[ch].To;
-    float S = _heatFluxCal[ch].So + (deltaT * _heatFluxCal[ch].Sc);
+    float deltaT = sensorTemp - _heatFluxCal[_cal(ch)].To;
+    float S = _heatFluxCal[_cal(ch)].So + (deltaT * _heatFluxCal[_cal(ch)].Sc);
     
     return S;
 }
 
 float ADS1220_NTC_Extended::readHeatFlux(ADS1220_Channel channel, float sensorTemp) {
+    float heatFlux;
+    _readHeatFlux(channel, sensorTemp, heatFlux);
+    return heatFlux;
+}
+
+bool ADS1220_NTC_Extended::_readHeatFlux(ADS1220_Channel channel, float sensorTemp, float &heatFlux) {
     uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    _hfSensorTemp[ch] = sensorTemp;
     
-    float voltage_uV = readHeatFluxVoltage(channel);
+    float voltage_uV;
+    bool valid = _readHeatFluxVoltage(channel, voltage_uV);
     float S_corrected = getTemperatureCorrectedSensitivity(channel, sensorTemp);
     
     // φ = U / S  [W/m²]
-    float heatFlux = voltage_uV / S_corrected;
+    heatFlux = voltage_uV / S_corrected;
     
+#if ADS1220_DEBUG_STATE
     _lastHeatFlux = heatFlux;
-    return heatFlux;
+#endif
+    if (valid) {
+        _setLastSampleValue(heatFlux, ADS1220_SAMPLE_HEAT_FLUX);
+    }
+    return valid;
 }
 
 float ADS1220_NTC_Extended::readHeatFluxUncorrected(ADS1220_Channel channel) {
     uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
     
-    float voltage_uV = readHeatFluxVoltage(channel);
+    float voltage_uV;
+    bool valid = _readHeatFluxVoltage(channel, voltage_uV);
     
     // φ = U / So  [W/m²]  (sin corrección de temperatura)
-    float heatFlux = voltage_uV / _heatFluxCal[ch].So;
+    float heatFlux = voltage_uV / _heatFluxCal[_cal(ch)].So;
     
+#if ADS1220_DEBUG_STATE
     _lastHeatFlux = heatFlux;
+#endif
+    if (valid) {
+        _setLastSampleValue(heatFlux, ADS1220_SAMPLE_HEAT_FLUX);
+    }
     return heatFlux;
 }
 
 float ADS1220_NTC_Extended::readHeatFluxFiltered(ADS1220_Channel channel, float sensorTemp) {
-    float heatFlux = readHeatFlux(channel, sensorTemp);
+    float heatFlux;
+    if (!_readHeatFlux(channel, sensorTemp, heatFlux)) {
+        return heatFlux;  // Lectura fallida o saturada: sin filtrar y fuera del filtro
+    }
+    if (_stageActive(channel)) {
+        return _stageValue[channel];  // _finishRead() ya pasó esta muestra por el filtro
+    }
     return updateMovingAverage(channel, heatFlux);
 }
 
@@ -364,9 +898,11 @@ float ADS1220_NTC_Extended::readThermalPower(ADS1220_Channel channel, float sens
     float heatFlux = readHeatFlux(channel, sensorTemp);
     
     // Φ = φ * A  [W]
-    float thermalPower = heatFlux * _heatFluxCal[ch].sensorArea;
+    float thermalPower = heatFlux * _heatFluxCal[_cal(ch)].sensorArea;
     
+#if ADS1220_DEBUG_STATE
     _lastThermalPower = thermalPower;
+#endif
     return thermalPower;
 }
 
@@ -374,95 +910,744 @@ float ADS1220_NTC_Extended::readThermalPowerFiltered(ADS1220_Channel channel, fl
     float heatFlux = readHeatFluxFiltered(channel, sensorTemp);
     
     uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
-    float thermalPower = heatFlux * _heatFluxCal[ch].sensorArea;
+    float thermalPower = heatFlux * _heatFluxCal[_cal(ch)].sensorArea;
     
+#if ADS1220_DEBUG_STATE
     _lastThermalPower = thermalPower;
+#endif
     return thermalPower;
 }
 
 // =============================================================================
-// CONFIGURACIÓN DEL ADC
+// ACUMULADOR DE ENERGÍA TÉRMICA
 // =============================================================================
 
-void ADS1220_NTC_Extended::setGain(uint8_t gain) {
-    // Actualizar registro del hardware
-    _reg0 = (_reg0 & 0xF1) | (gain & 0x0E);
-    writeRegister(ADS1220_REG0, _reg0);
-    
-    // Guardar valor numérico de ganancia
-    // Convertir bits de registro a valor numérico
-    uint8_t gainBits = (gain >> 1) & 0x07;
-    switch(gainBits) {
-        case 0: _currentGain = 1; break;
-        case 1: _currentGain = 2; break;
-        case 2: _currentGain = 4; break;
-        case 3: _currentGain = 8; break;
-        case 4: _currentGain = 16; break;
-        case 5: _currentGain = 32; break;
-        case 6: _currentGain = 64; break;
-        case 7: _currentGain = 128; break;
-        default: _currentGain = 1; break;
+#if ADS1220_ENERGY_ACCUMULATOR
+
+void ADS1220_NTC_Extended::enableEnergyAccumulator(ADS1220_Channel channel, bool enable) {
+    resetEnergyAccumulator(channel);
+    _energy[channel].enabled = enable;
+}
+
+void ADS1220_NTC_Extended::setEnergyWindow(ADS1220_Channel channel, uint32_t window_ms) {
+    if (window_ms == 0) window_ms = 1;
+    if (window_ms > 4000000UL) window_ms = 4000000UL;  // Límite de uint32_t en µs
+    _energy[channel].window_us = window_ms * 1000UL;
+    _energy[channel].windowEnergy = 0.0f;
+    _energy[channel].windowElapsed_us = 0;
+}
+
+bool ADS1220_NTC_Extended::getEnergySnapshot(ADS1220_Channel channel, ADS1220_EnergySnapshot &snapshot, bool reset) {
+    EnergyAccumulator &acc = _energy[channel];
+    
+    ADS1220_SNAPSHOT_LOCK();
+    snapshot.energy_J = acc.energy.sum;
+    snapshot.fluence_Jm2 = acc.fluence.sum;
+    snapshot.elapsed_s = (float)acc.elapsed_us * 1e-6f;
+    snapshot.meanPower_W = (acc.elapsed_us > 0) ? acc.energy.sum / snapshot.elapsed_s : 0.0f;
+    snapshot.windowPower_W = acc.windowPower;
+    snapshot.samples = acc.samples;
+    
+    if (reset) {
+        // La última muestra sigue siendo el inicio del próximo trapecio:
+        // ningún intervalo se pierde ni se cuenta dos veces entre snapshots
+        bool primed = acc.primed;
+        uint32_t prevTimestamp = acc.prevTimestamp;
+        float prevFlux = acc.prevFlux;
+        _resetEnergy(acc);
+        acc.primed = primed;
+        acc.prevTimestamp = prevTimestamp;
+        acc.prevFlux = prevFlux;
     }
+    ADS1220_SNAPSHOT_UNLOCK();
+    return acc.enabled;
 }
 
-void ADS1220_NTC_Extended::setPGABypass(bool bypass) {
-    // Bit 0 de Registro 0: PGA_BYPASS
-    // 0 = PGA habilitado (default)
-    // 1 = PGA deshabilitado (bypass)
+void ADS1220_NTC_Extended::resetEnergyAccumulator(ADS1220_Channel channel) {
+    ADS1220_SNAPSHOT_LOCK();
+    _resetEnergy(_energy[channel]);
+    ADS1220_SNAPSHOT_UNLOCK();
+}
+
+void ADS1220_NTC_Extended::_resetEnergy(EnergyAccumulator &acc) {
+    acc.energy.reset();
+    acc.fluence.reset();
+    acc.elapsed_us = 0;
+    acc.samples = 0;
+    acc.prevTimestamp = 0;
+    acc.prevFlux = 0.0f;
+    acc.windowEnergy = 0.0f;
+    acc.windowElapsed_us = 0;
+    acc.windowPower = 0.0f;
+    acc.primed = false;
+}
+
+void ADS1220_NTC_Extended::_accumulateEnergy(uint8_t ch, const ADS1220_Sample &sample) {
+    EnergyAccumulator &acc = _energy[ch];
     
-    if (bypass) {
-        _reg0 |= ADS1220_PGA_BYPASSED;   // Set bit 0 = 1
-    } else {
-        _reg0 &= ~ADS1220_PGA_BYPASSED;  // Clear bit 0 = 0
+    ADS1220_SNAPSHOT_LOCK();
+    if (acc.primed) {
+        uint32_t dt_us = sample.timestamp - acc.prevTimestamp;
+        float dt = (float)dt_us * 1e-6f;
+        
+        // Trapecio entre la muestra anterior y esta: ∫φ dt [J/m²] y ∫Φ dt [J]
+        float fluence = 0.5f * (acc.prevFlux + sample.value) * dt;
+        float energy = fluence * _heatFluxCal[_cal(ch)].sensorArea;
+        acc.fluence.add(fluence);
+        acc.energy.add(energy);
+        acc.elapsed_us += dt_us;
+        
+        // Ventana fija: potencia media de la última ventana completa
+        acc.windowEnergy += energy;
+        acc.windowElapsed_us += dt_us;
+        if (acc.windowElapsed_us >= acc.window_us) {
+            acc.windowPower = acc.windowEnergy / ((float)acc.windowElapsed_us * 1e-6f);
+            acc.windowEnergy = 0.0f;
+            acc.windowElapsed_us = 0;
+        }
     }
     
-    writeRegister(ADS1220_REG0, _reg0);
-    
-    // Nota: Al deshabilitar PGA, solo ganancias 1, 2, 4 están disponibles
-    // Ganancias mayores requieren PGA habilitado
-}
-
-void ADS1220_NTC_Extended::setDataRate(uint8_t dataRate) {
-    _reg1 = (_reg1 & 0x1F) | (dataRate & 0xE0);
-    writeRegister(ADS1220_REG1, _reg1);
+    acc.prevTimestamp = sample.timestamp;
+    acc.prevFlux = sample.value;
+    acc.primed = true;
+    acc.samples++;
+    ADS1220_SNAPSHOT_UNLOCK();
 }
 
-void ADS1220_NTC_Extended::setConversionMode(uint8_t mode) {
-    _reg1 = (_reg1 & 0xFB) | (mode & 0x04);
-    writeRegister(ADS1220_REG1, _reg1);
-    startConversion();
+void ADS1220_NTC_Extended::_breakEnergy(uint8_t ch) {
+    // Muestra saturada: el tramo hasta la siguiente válida no se integra (ni
+    // cuenta en el tiempo), en lugar de tender un trapecio sobre el hueco
+    ADS1220_SNAPSHOT_LOCK();
+    _energy[ch].primed = false;
+    ADS1220_SNAPSHOT_UNLOCK();
 }
 
-// =============================================================================
-// CONTROL
-// =============================================================================
+#else // ADS1220_ENERGY_ACCUMULATOR == 0
 
-void ADS1220_NTC_Extended::startConversion() {
-    sendCommand(ADS1220_CMD_START_SYNC);
+// Acumulador deshabilitado en compilación: sin energía que consultar
+void ADS1220_NTC_Extended::enableEnergyAccumulator(ADS1220_Channel, bool) {
 }
 
-bool ADS1220_NTC_Extended::dataReady() {
-    if (_drdyPin != 255) {
-        return (digitalRead(_drdyPin) == LOW);
-    }
-    return true;
+void ADS1220_NTC_Extended::setEnergyWindow(ADS1220_Channel, uint32_t) {
 }
 
-void ADS1220_NTC_Extended::powerDown() {
-    sendCommand(ADS1220_CMD_POWERDOWN);
+bool ADS1220_NTC_Extended::getEnergySnapshot(ADS1220_Channel, ADS1220_EnergySnapshot &snapshot, bool) {
+    memset(&snapshot, 0, sizeof(snapshot));
+    return false;
 }
 
-void ADS1220_NTC_Extended::reset() {
-    sendCommand(ADS1220_CMD_RESET);
-    delay(1);
+void ADS1220_NTC_Extended::resetEnergyAccumulator(ADS1220_Channel) {
 }
 
+#endif // ADS1220_ENERGY_ACCUMULATOR
+
 // =============================================================================
-// DEBUG
+// ESTADÍSTICAS POR CONVERSIÓN
 // =============================================================================
 
-void ADS1220_NTC_Extended::printRegisters(Stream* serial) {
-    serial->println(F("=== ADS1220 Registros ==="));
+#if ADS1220_STATISTICS
+
+void ADS1220_NTC_Extended::enableStatistics(ADS1220_Channel channel, bool enable) {
+    resetStatistics(channel);
+    _stats[channel].enabled = enable;
+}
+
+bool ADS1220_NTC_Extended::getStatistics(ADS1220_Channel channel, ADS1220_Statistics &stats, bool reset) {
+    RunningStatistics &run = _stats[channel];
+    
+    ADS1220_SNAPSHOT_LOCK();
+    RunningStatistics copy = run;
+    if (reset) {
+        _resetStatistics(run);
+    }
+    ADS1220_SNAPSHOT_UNLOCK();
+    
+    // Derivados fuera de la sección crítica (sqrt y divisiones)
+    _deriveStatistics(copy, stats);
+    return copy.enabled;
+}
+
+void ADS1220_NTC_Extended::setStatisticsInterval(ADS1220_Channel channel, uint32_t interval_ms) {
+    if (interval_ms > 4000000UL) interval_ms = 4000000UL;  // Límite de uint32_t en µs
+    // 0 detiene el flujo de bloques junto con las estadísticas que lo alimentan
+    enableStatistics(channel, interval_ms != 0);
+    ADS1220_SNAPSHOT_LOCK();
+    _statsInterval_us[channel] = interval_ms * 1000UL;
+    _statsBlockReady[channel] = false;
+    ADS1220_SNAPSHOT_UNLOCK();
+}
+
+bool ADS1220_NTC_Extended::readStatisticsBlock(ADS1220_Channel channel, ADS1220_Statistics &stats) {
+    ADS1220_SNAPSHOT_LOCK();
+    bool ready = _statsBlockReady[channel];
+    if (ready) {
+        stats = _statsBlock[channel];
+        _statsBlockReady[channel] = false;
+    }
+    ADS1220_SNAPSHOT_UNLOCK();
+    return ready;
+}
+
+void ADS1220_NTC_Extended::resetStatistics(ADS1220_Channel channel) {
+    ADS1220_SNAPSHOT_LOCK();
+    _resetStatistics(_stats[channel]);
+    ADS1220_SNAPSHOT_UNLOCK();
+}
+
+void ADS1220_NTC_Extended::_resetStatistics(RunningStatistics &run) {
+    run.count = 0;
+    run.mean = 0.0f;
+    run.m2 = 0.0f;
+    run.min = 0.0f;
+    run.max = 0.0f;
+    run.firstTimestamp = 0;
+    run.lastTimestamp = 0;
+}
+
+void ADS1220_NTC_Extended::_updateStatistics(uint8_t ch, const ADS1220_Sample &sample) {
+    RunningStatistics &run = _stats[ch];
+    float x = sample.value;
+    
+    ADS1220_SNAPSHOT_LOCK();
+    
+    // Bloque periódico cumplido: se cierra antes de añadir esta muestra, que
+    // abre el siguiente (el periodo medio no deriva con la tasa de muestreo)
+    bool publish = _statsInterval_us[ch] != 0 && run.count > 0 &&
+                   (sample.timestamp - run.firstTimestamp) >= _statsInterval_us[ch];
+    RunningStatistics block;
+    if (publish) {
+        block = run;
+        _resetStatistics(run);
+    }
+    
+    if (run.count == 0) {
+        run.min = x;
+        run.max = x;
+        run.firstTimestamp = sample.timestamp;
+    } else {
+        if (x < run.min) run.min = x;
+        if (x > run.max) run.max = x;
+    }
+    
+    // Welford: media y Σ(x - media)² sin restar sumas grandes
+    run.count++;
+    float delta = x - run.mean;
+    run.mean += delta / (float)run.count;
+    run.m2 += delta * (x - run.mean);
+    run.lastTimestamp = sample.timestamp;
+    ADS1220_SNAPSHOT_UNLOCK();
+    
+    if (publish) {
+        ADS1220_Statistics stats;
+        _deriveStatistics(block, stats);
+        ADS1220_SNAPSHOT_LOCK();
+        _statsBlock[ch] = stats;
+        _statsBlockReady[ch] = true;
+        ADS1220_SNAPSHOT_UNLOCK();
+    }
+}
+
+void ADS1220_NTC_Extended::_deriveStatistics(const RunningStatistics &run, ADS1220_Statistics &stats) {
+    stats.count = run.count;
+    stats.mean = run.mean;
+    stats.stddev = (run.count > 1) ? sqrt(run.m2 / (float)(run.count - 1)) : 0.0f;
+    stats.min = run.min;
+    stats.max = run.max;
+    stats.duration_s = (run.count > 1) ? (float)(run.lastTimestamp - run.firstTimestamp) * 1e-6f : 0.0f;
+}
+
+#else // ADS1220_STATISTICS == 0
+
+// Estadísticas deshabilitadas en compilación
+void ADS1220_NTC_Extended::enableStatistics(ADS1220_Channel, bool) {
+}
+
+bool ADS1220_NTC_Extended::getStatistics(ADS1220_Channel, ADS1220_Statistics &stats, bool) {
+    memset(&stats, 0, sizeof(stats));
+    return false;
+}
+
+void ADS1220_NTC_Extended::setStatisticsInterval(ADS1220_Channel, uint32_t) {
+}
+
+bool ADS1220_NTC_Extended::readStatisticsBlock(ADS1220_Channel, ADS1220_Statistics &) {
+    return false;
+}
+
+void ADS1220_NTC_Extended::resetStatistics(ADS1220_Channel) {
+}
+
+#endif // ADS1220_STATISTICS
+
+// =============================================================================
+// CONFIGURACIÓN DEL ADC
+// =============================================================================
+
+void ADS1220_NTC_Extended::setGain(uint8_t gain) {
+    // Actualizar registro del hardware
+    _reg0 = (_reg0 & 0xF1) | (gain & 0x0E);
+    writeRegister(ADS1220_REG0, _reg0);
+    
+    // Guardar valor numérico de ganancia
+    // Convertir bits de registro a valor numérico
+    uint8_t gainBits = (gain >> 1) & 0x07;
+    switch(gainBits) {
+        case 0: _currentGain = 1; break;
+        case 1: _currentGain = 2; break;
+        case 2: _currentGain = 4; break;
+        case 3: _currentGain = 8; break;
+        case 4: _currentGain = 16; break;
+        case 5: _currentGain = 32; break;
+        case 6: _currentGain = 64; break;
+        case 7: _currentGain = 128; break;
+        default: _currentGain = 1; break;
+    }
+    _updateRatiometricScale();
+}
+
+void ADS1220_NTC_Extended::setPGABypass(bool bypass) {
+    // Bit 0 de Registro 0: PGA_BYPASS
+    // 0 = PGA habilitado (default)
+    // 1 = PGA deshabilitado (bypass)
+    
+    if (bypass) {
+        _reg0 |= ADS1220_PGA_BYPASSED;   // Set bit 0 = 1
+    } else {
+        _reg0 &= ~ADS1220_PGA_BYPASSED;  // Clear bit 0 = 0
+    }
+    
+    writeRegister(ADS1220_REG0, _reg0);
+    
+    // Nota: Al deshabilitar PGA, solo ganancias 1, 2, 4 están disponibles
+    // Ganancias mayores requieren PGA habilitado
+}
+
+void ADS1220_NTC_Extended::setDataRate(uint8_t dataRate) {
+    _reg1 = (_reg1 & 0x1F) | (dataRate & 0xE0);
+    writeRegister(ADS1220_REG1, _reg1);
+}
+
+void ADS1220_NTC_Extended::setConversionMode(uint8_t mode) {
+    _reg1 = (_reg1 & 0xFB) | (mode & 0x04);
+    writeRegister(ADS1220_REG1, _reg1);
+    startConversion();
+}
+
+// =============================================================================
+// CALIBRACIÓN DE OFFSET
+// =============================================================================
+
+bool ADS1220_NTC_Extended::calibrateOffset(uint8_t samples) {
+    if (_readState != STATE_IDLE) {
+        return false;
+    }
+    if (samples < 1) samples = 1;
+    if (samples > 64) samples = 64;
+    
+    int32_t offset;
+    if (!_measureShortedInput(samples, offset)) {
+        return false;
+    }
+    
+    uint8_t gainIndex = (_reg0 >> 1) & 0x07;
+    _offsetTable[gainIndex] = (int16_t)offset;
+    _offsetValid |= (1 << gainIndex);
+    _conversionsSinceRefresh = 0;
+    return true;
+}
+
+bool ADS1220_NTC_Extended::calibrateAllOffsets(uint8_t samples) {
+    uint8_t originalGain = _reg0 & 0x0E;
+    bool success = true;
+    
+    for (uint8_t gainIndex = 0; gainIndex < 8; gainIndex++) {
+        setGain(gainIndex << 1);
+        if (!calibrateOffset(samples)) {
+            success = false;
+        }
+    }
+    
+    setGain(originalGain);
+    return success;
+}
+
+void ADS1220_NTC_Extended::setOffsetCorrection(bool enable) {
+    _offsetCorrection = enable;
+}
+
+void ADS1220_NTC_Extended::setOffsetRefreshInterval(uint16_t conversions) {
+    _offsetRefreshInterval = conversions;
+    _conversionsSinceRefresh = 0;
+}
+
+int16_t ADS1220_NTC_Extended::getOffset(uint8_t gain) {
+    uint8_t gainIndex = (gain >> 1) & 0x07;
+    return _offsetTable[gainIndex];
+}
+
+void ADS1220_NTC_Extended::setOffset(uint8_t gain, int16_t offset) {
+    uint8_t gainIndex = (gain >> 1) & 0x07;
+    _offsetTable[gainIndex] = offset;
+    _offsetValid |= (1 << gainIndex);
+}
+
+// =============================================================================
+// CONFIGURACIÓN PERSISTENTE
+// =============================================================================
+
+void ADS1220_NTC_Extended::exportConfiguration(ADS1220_Config &config) {
+    config.registers[0] = _reg0;
+    config.registers[1] = _reg1;
+    config.registers[2] = _reg2;
+    config.registers[3] = _reg3;
+    
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        config.channelMode[ch] = (uint8_t)_channelMode[ch];
+        config.chopEnabled[ch] = _chopEnabled[ch] ? 1 : 0;
+        config.ntcA[ch] = _ntc_A[_cal(ch)];
+        config.ntcB[ch] = _ntc_B[_cal(ch)];
+        config.ntcC[ch] = _ntc_C[_cal(ch)];
+        config.hfSo[ch] = _heatFluxCal[_cal(ch)].So;
+        config.hfSc[ch] = _heatFluxCal[_cal(ch)].Sc;
+        config.hfTo[ch] = _heatFluxCal[_cal(ch)].To;
+        config.hfArea[ch] = _heatFluxCal[_cal(ch)].sensorArea;
+        config.refResistance[ch] = _refResistance[ch];
+    }
+    config.idacCurrent = _idacCurrent;
+    
+    for (uint8_t i = 0; i < 8; i++) {
+        config.offsetTable[i] = _offsetTable[i];
+    }
+    config.offsetValid = _offsetValid;
+    config.offsetCorrection = _offsetCorrection ? 1 : 0;
+    config.avgSize = _avgSize;
+    config.settleTime_us = _settleTime_us;
+    
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        config.hfSensorTemp[ch] = _hfSensorTemp[ch];
+        config.modelEnabled[ch] = _modelEnabled[ch] ? 1 : 0;
+        config.modelMinTemp[ch] = _modelMinTemp[ch];
+        config.modelMaxTemp[ch] = _modelMaxTemp[ch];
+    }
+}
+
+void ADS1220_NTC_Extended::importConfiguration(const ADS1220_Config &config) {
+    _reg0 = config.registers[0];
+    _reg1 = config.registers[1];
+    _reg2 = config.registers[2];
+    _reg3 = config.registers[3];
+    _currentGain = (uint8_t)(1 << ((_reg0 >> 1) & 0x07));
+    
+    // Con ADS1220_CALIBRATION_CHANNELS = 1 el canal 1 queda como calibración común
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        _channelMode[ch] = (config.channelMode[ch] == MODE_HEAT_FLUX) ? MODE_HEAT_FLUX : MODE_NTC;
+        _chopEnabled[ch] = (config.chopEnabled[ch] != 0);
+        _ntc_A[_cal(ch)] = config.ntcA[ch];
+        _ntc_B[_cal(ch)] = config.ntcB[ch];
+        _ntc_C[_cal(ch)] = config.ntcC[ch];
+        _heatFluxCal[_cal(ch)].So = config.hfSo[ch];
+        _heatFluxCal[_cal(ch)].Sc = config.hfSc[ch];
+        _heatFluxCal[_cal(ch)].To = config.hfTo[ch];
+        _heatFluxCal[_cal(ch)].sensorArea = config.hfArea[ch];
+        _refResistance[ch] = config.refResistance[ch];
+    }
+    _idacCurrent = config.idacCurrent;
+    _updateRatiometricScale();
+    _modelDirty = 0x03;
+    
+    for (uint8_t i = 0; i < 8; i++) {
+        _offsetTable[i] = config.offsetTable[i];
+    }
+    _offsetValid = config.offsetValid;
+    _offsetCorrection = (config.offsetCorrection != 0);
+    
+    setMovingAverageSize(config.avgSize);
+    _settleTime_us = config.settleTime_us;
+    
+    // Entradas de _computeValue() fuera de la calibración (el modelo directo
+    // se reajusta en la primera conversión: _modelDirty ya está marcado)
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        _hfSensorTemp[ch] = config.hfSensorTemp[ch];
+        _modelEnabled[ch] = (config.modelEnabled[ch] != 0);
+        _modelMinTemp[ch] = config.modelMinTemp[ch];
+        _modelMaxTemp[ch] = config.modelMaxTemp[ch];
+    }
+}
+
+bool ADS1220_NTC_Extended::saveConfiguration(uint16_t slot) {
+    ADS1220_Config config;
+    uint8_t image[ADS1220_CONFIG_SIZE];
+    exportConfiguration(config);
+    ADS1220_encodeConfig(image, config);
+    
+#if defined(__AVR__)
+    uint16_t address = ADS1220_EEPROM_ADDRESS + slot * ADS1220_CONFIG_SIZE;
+    if ((uint32_t)address + ADS1220_CONFIG_SIZE > EEPROM.length()) {
+        return false;
+    }
+    // update(): solo escribe las celdas que cambian (desgaste de la EEPROM)
+    for (uint16_t i = 0; i < ADS1220_CONFIG_SIZE; i++) {
+        EEPROM.update(address + i, image[i]);
+    }
+    return true;
+#elif defined(ESP32)
+    Preferences prefs;
+    char key[10];
+    snprintf(key, sizeof(key), "cfg%u", (unsigned)slot);
+    if (!prefs.begin(ADS1220_NVS_NAMESPACE, false)) {
+        return false;
+    }
+    
+    // Sin escritura si la imagen guardada es idéntica
+    uint8_t stored[ADS1220_CONFIG_SIZE];
+    bool written = (prefs.getBytes(key, stored, sizeof(stored)) == sizeof(stored) &&
+                    memcmp(stored, image, sizeof(image)) == 0);
+    if (!written) {
+        written = (prefs.putBytes(key, image, sizeof(image)) == sizeof(image));
+    }
+    prefs.end();
+    return written;
+#else
+    (void)slot;  // Sin memoria no volátil conocida
+    return false;
+#endif
+}
+
+bool ADS1220_NTC_Extended::loadConfiguration(uint16_t slot) {
+    uint8_t image[ADS1220_CONFIG_SIZE];
+    
+#if defined(__AVR__)
+    uint16_t address = ADS1220_EEPROM_ADDRESS + slot * ADS1220_CONFIG_SIZE;
+    if ((uint32_t)address + ADS1220_CONFIG_SIZE > EEPROM.length()) {
+        return false;
+    }
+    for (uint16_t i = 0; i < ADS1220_CONFIG_SIZE; i++) {
+        image[i] = EEPROM.read(address + i);
+    }
+#elif defined(ESP32)
+    Preferences prefs;
+    char key[10];
+    snprintf(key, sizeof(key), "cfg%u", (unsigned)slot);
+    if (!prefs.begin(ADS1220_NVS_NAMESPACE, true)) {
+        return false;
+    }
+    size_t length = prefs.getBytes(key, image, sizeof(image));
+    prefs.end();
+    if (length != sizeof(image)) {
+        return false;
+    }
+#else
+    (void)slot;  // Sin memoria no volátil conocida
+    return false;
+#endif
+    
+    ADS1220_Config config;
+    if (!ADS1220_decodeConfig(image, sizeof(image), config)) {
+        return false;
+    }
+    importConfiguration(config);
+    return true;
+}
+
+// =============================================================================
+// CONTROL
+// =============================================================================
+
+void ADS1220_NTC_Extended::startConversion() {
+    sendCommand(ADS1220_CMD_START_SYNC);
+}
+
+bool ADS1220_NTC_Extended::dataReady() {
+    if (_drdyPin != 255) {
+        return (digitalRead(_drdyPin) == LOW);
+    }
+    if (_transport != nullptr && _transport->hasDataReady()) {
+        return _transport->dataReady();
+    }
+    return true;
+}
+
+void ADS1220_NTC_Extended::powerDown() {
+    sendCommand(ADS1220_CMD_POWERDOWN);
+}
+
+void ADS1220_NTC_Extended::reset() {
+    sendCommand(ADS1220_CMD_RESET);
+    delay(1);
+}
+
+// =============================================================================
+// VIGILANCIA DE REGISTROS
+// =============================================================================
+
+void ADS1220_NTC_Extended::setRegisterWatchdog(uint16_t interval) {
+    _watchdogInterval = interval;
+    _watchdogCount = 0;
+}
+
+bool ADS1220_NTC_Extended::checkRegisters() {
+    if (_transport == nullptr || _readState != STATE_IDLE) {
+        return true;  // Durante una lectura la verifica poll()
+    }
+    return _verifyRegisters(_reg3);
+}
+
+bool ADS1220_NTC_Extended::_watchdogDue() {
+    if (_watchdogInterval == 0) {
+        return false;
+    }
+    if (++_watchdogCount < _watchdogInterval) {
+        return false;
+    }
+    _watchdogCount = 0;
+    return true;
+}
+
+bool ADS1220_NTC_Extended::_verifyRegisters(uint8_t expectedReg3) {
+    const uint8_t expected[4] = {_reg0, _reg1, _reg2, expectedReg3};
+    uint8_t chip[4];
+    
+    readRegisters(ADS1220_REG0, 4, chip);
+    _registerChecks++;
+    
+    // Un WREG por registro distinto, todos en la misma cola de transacciones
+    uint8_t writes[4][2];
+    ADS1220_Transaction queue[4];
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        if (chip[i] != expected[i]) {
+            writes[count][0] = ADS1220_CMD_WREG | (i << 2);
+            writes[count][1] = expected[i];
+            queue[count].tx = writes[count];
+            queue[count].rx = nullptr;
+            queue[count].length = 2;
+            count++;
+        }
+    }
+    
+    if (count == 0) {
+        return true;
+    }
+    _transport->transferQueue(queue, count);
+    _registerFaults++;
+    return false;
+}
+
+// =============================================================================
+// DIAGNÓSTICO DE SENSORES
+// =============================================================================
+
+#if ADS1220_SENSOR_DIAGNOSTICS
+
+void ADS1220_NTC_Extended::setSensorDiagnostics(uint16_t interval) {
+    _diagInterval = interval;
+    _diagSaturated = 0;
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        _diagCount[ch] = 0;
+        _diagHealth[ch] = HEALTH_UNKNOWN;
+        _diagResistance[ch] = 0.0f;
+    }
+}
+
+void ADS1220_NTC_Extended::setSensorResistanceRange(ADS1220_Channel channel, float minOhms, float maxOhms) {
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    _diagMinOhms[ch] = minOhms;
+    _diagMaxOhms[ch] = maxOhms;
+}
+
+ADS1220_ChannelHealth ADS1220_NTC_Extended::_saturatedDiagnostic(uint8_t ch, int32_t rawValue) {
+    // Una NTC sana de alta resistencia satura el BCS pero no la IDAC
+    if (rawValue >= ADS1220_SATURATION_CODE) {
+        return HEALTH_OPEN;
+    }
+    if (_diagMaxOhms[ch] > 0.0f && rawToResistance(ch, rawValue) > _diagMaxOhms[ch]) {
+        return HEALTH_OPEN;
+    }
+    return HEALTH_OUT_OF_RANGE;
+}
+
+ADS1220_ChannelHealth ADS1220_NTC_Extended::getChannelHealth(ADS1220_Channel channel) {
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    // El enum está ordenado por gravedad
+    return (_diagHealth[ch] > _rangeHealth[ch]) ? _diagHealth[ch] : _rangeHealth[ch];
+}
+
+float ADS1220_NTC_Extended::getSensorResistance(ADS1220_Channel channel) {
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    return _diagResistance[ch];
+}
+
+void ADS1220_NTC_Extended::_evaluateDiagnostic(uint8_t ch, int32_t code) {
+    if (code >= ADS1220_SATURATION_CODE) {
+        // Entrada abierta (las fuentes llevan AINP a AVDD y AINN a AVSS) o,
+        // en NTC, resistencia por encima de ~200 kΩ: lo decide la conversión
+        // con IDAC que sigue en esta misma lectura
+        _diagResistance[ch] = 0.0f;
+        if (_channelMode[ch] == MODE_NTC) {
+            _diagSaturated |= (uint8_t)(1 << ch);
+        } else {
+            _diagHealth[ch] = HEALTH_OPEN;
+        }
+        return;
+    }
+    
+    // Ganancia 1 y referencia interna: V = código × VREF / 2^23. En modo
+    // flujo se resta la tensión del propio gSKIN (última muestra del canal)
+    float voltage = (float)code * ADS1220_VREF / (float)ADS1220_MAX_CODE;
+    if (_channelMode[ch] == MODE_HEAT_FLUX) {
+        voltage -= _diagSignal[ch];
+    }
+    float resistance = voltage / ADS1220_BURNOUT_CURRENT;
+    _diagResistance[ch] = (resistance > 0.0f) ? resistance : 0.0f;
+    
+    if (resistance < _diagMinOhms[ch]) {
+        _diagHealth[ch] = HEALTH_SHORT;
+    } else if (_diagMaxOhms[ch] > 0.0f && resistance > _diagMaxOhms[ch]) {
+        _diagHealth[ch] = HEALTH_OUT_OF_RANGE;
+    } else {
+        _diagHealth[ch] = HEALTH_OK;
+    }
+}
+
+#else // ADS1220_SENSOR_DIAGNOSTICS == 0
+
+// Sin conversiones de burnout: la salud del canal es la comprobación de rango
+void ADS1220_NTC_Extended::setSensorDiagnostics(uint16_t) {
+}
+
+void ADS1220_NTC_Extended::setSensorResistanceRange(ADS1220_Channel, float, float) {
+}
+
+ADS1220_ChannelHealth ADS1220_NTC_Extended::getChannelHealth(ADS1220_Channel channel) {
+    return _rangeHealth[(channel == CHANNEL_0) ? 0 : 1];
+}
+
+float ADS1220_NTC_Extended::getSensorResistance(ADS1220_Channel) {
+    return 0.0f;
+}
+
+#endif // ADS1220_SENSOR_DIAGNOSTICS
+
+ADS1220_ChannelHealth ADS1220_NTC_Extended::_checkRange(uint8_t ch, int32_t rawValue, float value) {
+    if (rawValue >= ADS1220_SATURATION_CODE) {
+        // NTC abierta: la IDAC lleva la entrada hasta su límite de tensión
+        return (_channelMode[ch] == MODE_NTC) ? HEALTH_OPEN : HEALTH_OUT_OF_RANGE;
+    }
+    if (rawValue <= -ADS1220_SATURATION_CODE) {
+        return HEALTH_OUT_OF_RANGE;
+    }
+    if (_channelMode[ch] == MODE_NTC && !(value >= ADS1220_NTC_MIN_TEMP && value <= ADS1220_NTC_MAX_TEMP)) {
+        return HEALTH_OUT_OF_RANGE;  // También NaN (resistencia nula o negativa)
+    }
+    return HEALTH_OK;
+}
+
+// =============================================================================
+// DEBUG
+// =============================================================================
+
+void ADS1220_NTC_Extended::printRegisters(Stream* serial) {
+    serial->println(F("=== ADS1220 Registros ==="));
     
     uint8_t reg0 = readRegister(ADS1220_REG0);
     uint8_t reg1 = readRegister(ADS1220_REG1);
@@ -504,108 +1689,866 @@ void ADS1220_NTC_Extended::printLastReading(Stream* serial) {
     serial->println(_channelMode[ch] == MODE_NTC ? "NTC" : "Heat Flux");
     
     serial->print(F("RAW: ")); serial->println(_lastRawReading);
-    serial->print(F("Voltaje: ")); serial->print(_lastVoltage * 1000.0f, 4);
-    serial->println(F(" mV"));
     
     if (_channelMode[ch] == MODE_NTC) {
-        serial->print(F("Resistencia: ")); serial->print(_lastResistance / 1000.0f, 3);
+        // Derivados del código: el modelo directo no calcula V ni R
+        float resistance = rawToResistance(ch, _lastRawReading);
+        float voltage = (_refResistance[ch] > 0.0f) ? resistance * _idacCurrent
+                                                    : rawToVoltage(_lastRawReading);
+        serial->print(F("Voltaje: ")); serial->print(voltage * 1000.0f, 4);
+        serial->println(F(" mV"));
+        serial->print(F("Resistencia: ")); serial->print(resistance / 1000.0f, 3);
         serial->println(F(" kΩ"));
-        serial->print(F("Temperatura: ")); serial->print(_lastTemperature, 2);
+#if ADS1220_DEBUG_STATE
+        float temperature = _lastTemperature;
+#else
+        float temperature = _chainTemperature(ch, _lastRawReading);
+#endif
+        serial->print(F("Temperatura: ")); serial->print(temperature, 2);
         serial->println(F(" °C"));
     } else {
-        serial->print(F("Flujo Térmico: ")); serial->print(_lastHeatFlux, 2);
+#if ADS1220_DEBUG_STATE
+        float voltage = _lastVoltage;
+        float heatFlux = _lastHeatFlux;
+        float thermalPower = _lastThermalPower;
+#else
+        // Sin estado de debug: recalculados del último código
+        uint8_t cal = _cal(ch);
+        float voltage = rawToVoltage(_lastRawReading);
+        float S = _heatFluxCal[cal].So + (_hfSensorTemp[ch] - _heatFluxCal[cal].To) * _heatFluxCal[cal].Sc;
+        float heatFlux = voltage * 1e6f / S;
+        float thermalPower = heatFlux * _heatFluxCal[cal].sensorArea;
+#endif
+        serial->print(F("Voltaje: ")); serial->print(voltage * 1000.0f, 4);
+        serial->println(F(" mV"));
+        serial->print(F("Flujo Térmico: ")); serial->print(heatFlux, 2);
         serial->println(F(" W/m²"));
-        serial->print(F("Potencia Térmica: ")); serial->print(_lastThermalPower * 1000.0f, 3);
+        serial->print(F("Potencia Térmica: ")); serial->print(thermalPower * 1000.0f, 3);
         serial->println(F(" mW"));
     }
     serial->println();
 }
 
-void ADS1220_NTC_Extended::printHeatFluxInfo(ADS1220_Channel channel, Stream* serial) {
-    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
-    
-    serial->println(F("=== Calibración Heat Flux ==="));
-    serial->print(F("Canal: ")); serial->println(ch);
-    serial->print(F("So: ")); serial->print(_heatFluxCal[ch].So, 4);
-    serial->println(F(" µV/(W/m²)"));
-    serial->print(F("Sc: ")); serial->print(_heatFluxCal[ch].Sc, 6);
-    serial->println(F(" (µV/(W/m²))/°C"));
-    serial->print(F("To: ")); serial->print(_heatFluxCal[ch].To, 2);
-    serial->println(F(" °C"));
-    serial->print(F("Área: ")); serial->print(_heatFluxCal[ch].sensorArea * 1e6f, 2);
-    serial->println(F(" mm²"));
-    serial->println();
+void ADS1220_NTC_Extended::printHeatFluxInfo(ADS1220_Channel channel, Stream* serial) {
+    uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
+    
+    serial->println(F("=== Calibración Heat Flux ==="));
+    serial->print(F("Canal: ")); serial->println(ch);
+    serial->print(F("So: ")); serial->print(_heatFluxCal[_cal(ch)].So, 4);
+    serial->println(F(" µV/(W/m²)"));
+    serial->print(F("Sc: ")); serial->print(_heatFluxCal[_cal(ch)].Sc, 6);
+    serial->println(F(" (µV/(W/m²))/°C"));
+    serial->print(F("To: ")); serial->print(_heatFluxCal[_cal(ch)].To, 2);
+    serial->println(F(" °C"));
+    serial->print(F("Área: ")); serial->print(_heatFluxCal[_cal(ch)].sensorArea * 1e6f, 2);
+    serial->println(F(" mm²"));
+    serial->println();
+}
+
+bool ADS1220_NTC_Extended::testCommunication() {
+    uint8_t reg0 = readRegister(ADS1220_REG0);
+    
+    if (reg0 == 0xFF) {
+        return false;
+    }
+    
+    uint8_t originalValue = reg0;
+    writeRegister(ADS1220_REG0, 0xAA);
+    delayMicroseconds(100);
+    
+    uint8_t readback = readRegister(ADS1220_REG0);
+    
+    writeRegister(ADS1220_REG0, originalValue);
+    delayMicroseconds(100);
+    
+    return (readback == 0xAA);
+}
+
+void ADS1220_NTC_Extended::printFootprint(Stream* serial) {
+#if ADS1220_MAX_AVG_SIZE > 0
+    size_t filter = sizeof(_tempBuffer);
+#else
+    size_t filter = 0;
+#endif
+#if ADS1220_MODEL_SEGMENTS > 0
+    size_t model = sizeof(_model);
+#else
+    size_t model = 0;
+#endif
+#if ADS1220_DEBUG_STATE
+    size_t debug = 5 * sizeof(float);
+#else
+    size_t debug = 0;
+#endif
+#if ADS1220_RESPONSE_COMPENSATION
+    size_t compensation = sizeof(_compensator);
+#else
+    size_t compensation = 0;
+#endif
+#if ADS1220_SENSOR_DIAGNOSTICS
+    size_t diagnostics = sizeof(_diagInterval) + sizeof(_diagCount) + sizeof(_diagHealth) +
+                         sizeof(_diagResistance) + sizeof(_diagMinOhms) + sizeof(_diagMaxOhms) +
+                         sizeof(_diagSignal) + sizeof(_diagSaturated);
+#else
+    size_t diagnostics = 0;
+#endif
+#if ADS1220_DECIMATION
+    size_t decimated = sizeof(_decimator);
+#else
+    size_t decimated = 0;
+#endif
+#if ADS1220_STATISTICS
+    size_t statistics = sizeof(_stats) + sizeof(_statsInterval_us) + sizeof(_statsBlock) + sizeof(_statsBlockReady);
+#else
+    size_t statistics = 0;
+#endif
+#if ADS1220_EVENT_REPORTING
+    size_t events = sizeof(_events) + sizeof(_eventCallback) + sizeof(_eventContext) +
+                    sizeof(_eventQueue) + sizeof(_eventHead) + sizeof(_eventCount);
+#else
+    size_t events = 0;
+#endif
+#if ADS1220_ENERGY_ACCUMULATOR
+    size_t energy = sizeof(_energy);
+#else
+    size_t energy = 0;
+#endif
+#if ADS1220_PELTIER_CONTROL
+    size_t control = sizeof(_pid) + sizeof(_controlEnabled) + sizeof(_controlChannel) + sizeof(_pwmPin) +
+                     sizeof(_dirPin) + sizeof(_pwmMax) + sizeof(_controlLatency_us) +
+                     sizeof(_controlMaxLatency_us) + sizeof(_controlUpdates);
+#else
+    size_t control = 0;
+#endif
+    size_t calibration = sizeof(_ntc_A) + sizeof(_ntc_B) + sizeof(_ntc_C) + sizeof(_heatFluxCal);
+    size_t samples = sizeof(_samples) + sizeof(_sampleSensorTemp);
+    size_t arena = _filterExternal ? 2 * (size_t)_filterCapacity * sizeof(float) : 0;
+    size_t total = sizeof(*this);
+    size_t parts = filter + model + samples + diagnostics + decimated + statistics + events + energy +
+                   calibration + debug + compensation + control;
+    
+    serial->println(F("=== ADS1220 Memoria (bytes) ==="));
+    serial->print(F("Instancia: ")); serial->println((unsigned long)total);
+    serial->print(F("  Promedio móvil: ")); serial->print((unsigned long)filter);
+    serial->print(F(" (ADS1220_MAX_AVG_SIZE=")); serial->print(ADS1220_MAX_AVG_SIZE); serial->println(F(")"));
+    serial->print(F("  Modelo directo: ")); serial->print((unsigned long)model);
+    serial->print(F(" (ADS1220_MODEL_SEGMENTS=")); serial->print(ADS1220_MODEL_SEGMENTS); serial->println(F(")"));
+    serial->print(F("  Buffer de muestras: ")); serial->print((unsigned long)samples);
+    serial->print(F(" (ADS1220_SAMPLE_BUFFER_SIZE=")); serial->print(ADS1220_SAMPLE_BUFFER_SIZE); serial->println(F(")"));
+    serial->print(F("  Diagnóstico: ")); serial->print((unsigned long)diagnostics);
+    serial->print(F(" (ADS1220_SENSOR_DIAGNOSTICS=")); serial->print(ADS1220_SENSOR_DIAGNOSTICS); serial->println(F(")"));
+    serial->print(F("  Flujos diezmados: ")); serial->print((unsigned long)decimated);
+    serial->print(F(" (ADS1220_DECIMATION=")); serial->print(ADS1220_DECIMATION);
+    serial->print(F(", ADS1220_DECIMATED_BUFFER_SIZE=")); serial->print(ADS1220_DECIMATED_BUFFER_SIZE); serial->println(F(")"));
+    serial->print(F("  Estadísticas: ")); serial->print((unsigned long)statistics);
+    serial->print(F(" (ADS1220_STATISTICS=")); serial->print(ADS1220_STATISTICS); serial->println(F(")"));
+    serial->print(F("  Eventos: ")); serial->print((unsigned long)events);
+    serial->print(F(" (ADS1220_EVENT_REPORTING=")); serial->print(ADS1220_EVENT_REPORTING);
+    serial->print(F(", ADS1220_EVENT_BUFFER_SIZE=")); serial->print(ADS1220_EVENT_BUFFER_SIZE); serial->println(F(")"));
+    serial->print(F("  Energía: ")); serial->print((unsigned long)energy);
+    serial->print(F(" (ADS1220_ENERGY_ACCUMULATOR=")); serial->print(ADS1220_ENERGY_ACCUMULATOR); serial->println(F(")"));
+    serial->print(F("  Calibración: ")); serial->print((unsigned long)calibration);
+    serial->print(F(" (ADS1220_CALIBRATION_CHANNELS=")); serial->print(ADS1220_CALIBRATION_CHANNELS); serial->println(F(")"));
+    serial->print(F("  Debug: ")); serial->print((unsigned long)debug);
+    serial->print(F(" (ADS1220_DEBUG_STATE=")); serial->print(ADS1220_DEBUG_STATE); serial->println(F(")"));
+    serial->print(F("  Compensador: ")); serial->print((unsigned long)compensation);
+    serial->print(F(" (ADS1220_RESPONSE_COMPENSATION=")); serial->print(ADS1220_RESPONSE_COMPENSATION); serial->println(F(")"));
+    serial->print(F("  Control PID: ")); serial->print((unsigned long)control);
+    serial->print(F(" (ADS1220_PELTIER_CONTROL=")); serial->print(ADS1220_PELTIER_CONTROL); serial->println(F(")"));
+    serial->print(F("  Resto: ")); serial->println((unsigned long)(total - parts));
+    serial->print(F("Arena externa: ")); serial->println((unsigned long)arena);
+    serial->println();
+}
+
+// =============================================================================
+// REGISTRO Y STREAMING BINARIO DE MUESTRAS
+// =============================================================================
+
+uint8_t ADS1220_NTC_Extended::availableSamples() {
+    return _sampleCount;
+}
+
+bool ADS1220_NTC_Extended::readSample(ADS1220_Sample &sample) {
+    if (_sampleCount == 0) {
+        return false;
+    }
+    uint8_t tail = (uint8_t)((_sampleHead + ADS1220_SAMPLE_BUFFER_SIZE - _sampleCount) % ADS1220_SAMPLE_BUFFER_SIZE);
+    sample = _samples[tail];
+    _sampleCount--;
+    return true;
+}
+
+uint8_t ADS1220_NTC_Extended::writeBinaryFrame(Stream* serial, bool includeValue) {
+    if (_sampleCount == 0) {
+        return 0;
+    }
+    
+    uint8_t tail = (uint8_t)((_sampleHead + ADS1220_SAMPLE_BUFFER_SIZE - _sampleCount) % ADS1220_SAMPLE_BUFFER_SIZE);
+    uint32_t base = _samples[tail].timestamp;
+    
+    // Registros que caben en una trama (máximo de registros y de offset de tiempo)
+    uint8_t count = 0;
+    bool heatFlux = false;
+    while (count < _sampleCount && count < ADS1220_FRAME_MAX_RECORDS) {
+        const ADS1220_Sample &sample = _samples[(tail + count) % ADS1220_SAMPLE_BUFFER_SIZE];
+        if ((sample.timestamp - base) > ADS1220_RECORD_MAX_OFFSET) {
+            break;
+        }
+        heatFlux |= (sample.flags & ADS1220_SAMPLE_HEAT_FLUX) != 0;
+        count++;
+    }
+    
+    // Se codifica registro a registro: no hace falta un buffer de trama completo.
+    // El flujo depende de la temperatura del sensor, que puede cambiar en cada
+    // lectura: viaja con cada registro para que la grabación sea reproducible
+    uint8_t buffer[ADS1220_FRAME_HEADER_SIZE + ADS1220_RECORD_VALUE_SIZE + ADS1220_RECORD_SENSOR_TEMP_SIZE];  // Cabecera o registro
+    uint8_t frameFlags = includeValue ? ADS1220_FRAME_HAS_VALUE : 0;
+    if (heatFlux) {
+        frameFlags |= ADS1220_FRAME_HAS_SENSOR_TEMP;
+    }
+    size_t length = ADS1220_encodeHeader(buffer, ADS1220_FRAME_SAMPLES, frameFlags, count, _frameSequence, base);
+    uint16_t crc = ADS1220_crc16(buffer + 2, length - 2);
+    serial->write(buffer, length);
+    
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t index = (uint8_t)((tail + i) % ADS1220_SAMPLE_BUFFER_SIZE);
+        length = ADS1220_encodeRecord(buffer, _samples[index], base, includeValue,
+                                      heatFlux, _sampleSensorTemp[index]);
+        crc = ADS1220_crc16(buffer, length, crc);
+        serial->write(buffer, length);
+    }
+    
+    buffer[0] = (uint8_t)(crc & 0xFF);
+    buffer[1] = (uint8_t)(crc >> 8);
+    serial->write(buffer, ADS1220_FRAME_CRC_SIZE);
+    
+    _sampleCount -= count;
+    _frameSequence++;
+    return count;
+}
+
+size_t ADS1220_NTC_Extended::writeConfigFrame(Stream* serial) {
+    ADS1220_Config config;
+    uint8_t buffer[ADS1220_CONFIG_FRAME_SIZE];
+    exportConfiguration(config);
+    
+    size_t length = ADS1220_encodeConfigFrame(buffer, _frameSequence, micros(), config);
+    serial->write(buffer, length);
+    _frameSequence++;
+    return length;
+}
+
+bool ADS1220_NTC_Extended::replaySample(const ADS1220_Sample &recorded, ADS1220_Sample &sample,
+                                        float sensorTemp) {
+    if (_readState != STATE_IDLE || recorded.channel > 1) {
+        return false;
+    }
+    
+    // VALUE_VALID, HEAT_FLUX y OVERRUN los vuelve a decidir el pipeline
+    const uint8_t kept = ADS1220_SAMPLE_CHOPPED | ADS1220_SAMPLE_OFFSET_CORRECTED |
+                         ADS1220_SAMPLE_CONFIG_FAULT | ADS1220_SAMPLE_SENSOR_FAULT;
+    _readChannel = (recorded.channel == 0) ? CHANNEL_0 : CHANNEL_1;
+    if (!isnan(sensorTemp)) {
+        _hfSensorTemp[recorded.channel] = sensorTemp;
+    }
+    _replaying = true;
+    _finishRead(recorded.raw, recorded.flags & kept, recorded.timestamp, sample);
+    _replaying = false;
+    return true;
+}
+
+void ADS1220_NTC_Extended::_pushSample(const ADS1220_Sample &sample) {
+    ADS1220_SNAPSHOT_LOCK();
+    _samples[_sampleHead] = sample;
+    _sampleSensorTemp[_sampleHead] = _hfSensorTemp[sample.channel];
+    _sampleTotal++;
+    
+    _sampleHead = (uint8_t)((_sampleHead + 1) % ADS1220_SAMPLE_BUFFER_SIZE);
+    if (_sampleCount < ADS1220_SAMPLE_BUFFER_SIZE) {
+        _sampleCount++;
+    } else {
+        // Buffer lleno: se perdió el registro más antiguo
+        _samples[_sampleHead].flags |= ADS1220_SAMPLE_OVERRUN;
+    }
+    ADS1220_SNAPSHOT_UNLOCK();
+}
+
+void ADS1220_NTC_Extended::_setLastSampleValue(float value, uint8_t flags) {
+    if (_sampleCount == 0) {
+        return;
+    }
+    uint8_t last = (uint8_t)((_sampleHead + ADS1220_SAMPLE_BUFFER_SIZE - 1) % ADS1220_SAMPLE_BUFFER_SIZE);
+    _samples[last].value = value;
+    _samples[last].flags |= ADS1220_SAMPLE_VALUE_VALID | flags;
+}
+
+// =============================================================================
+// SALIDA MULTI-TASA
+// =============================================================================
+
+void ADS1220_NTC_Extended::attachSampleCursor(ADS1220_SampleCursor &cursor, bool fromOldest) {
+    ADS1220_SNAPSHOT_LOCK();
+    cursor.position = _sampleTotal;
+    if (fromOldest) {
+        cursor.position -= (_sampleTotal < ADS1220_SAMPLE_BUFFER_SIZE) ? _sampleTotal : ADS1220_SAMPLE_BUFFER_SIZE;
+    }
+    cursor.lost = 0;
+    ADS1220_SNAPSHOT_UNLOCK();
+}
+
+uint8_t ADS1220_NTC_Extended::availableSamples(const ADS1220_SampleCursor &cursor) {
+    uint32_t behind = _sampleTotal - cursor.position;
+    return (uint8_t)((behind < ADS1220_SAMPLE_BUFFER_SIZE) ? behind : ADS1220_SAMPLE_BUFFER_SIZE);
+}
+
+bool ADS1220_NTC_Extended::readSample(ADS1220_SampleCursor &cursor, ADS1220_Sample &sample) {
+    uint8_t overrun = 0;
+    
+    ADS1220_SNAPSHOT_LOCK();
+    // Solo se usan diferencias de posiciones: válido aunque _sampleTotal dé la vuelta
+    uint32_t behind = _sampleTotal - cursor.position;
+    if (behind == 0) {
+        ADS1220_SNAPSHOT_UNLOCK();
+        return false;
+    }
+    if (behind > ADS1220_SAMPLE_BUFFER_SIZE) {
+        cursor.lost += behind - ADS1220_SAMPLE_BUFFER_SIZE;
+        behind = ADS1220_SAMPLE_BUFFER_SIZE;
+        overrun = ADS1220_SAMPLE_OVERRUN;
+    }
+    sample = _samples[(_sampleHead + ADS1220_SAMPLE_BUFFER_SIZE - behind) % ADS1220_SAMPLE_BUFFER_SIZE];
+    cursor.position = _sampleTotal - behind + 1;
+    ADS1220_SNAPSHOT_UNLOCK();
+    
+    // ADS1220_SAMPLE_OVERRUN del buffer se refiere al consumidor sin cursor
+    sample.flags = (sample.flags & ~ADS1220_SAMPLE_OVERRUN) | overrun;
+    return true;
+}
+
+#if ADS1220_DECIMATION
+
+void ADS1220_NTC_Extended::setDecimatedRate(ADS1220_Channel channel, float rate_Hz) {
+    Decimator &dec = _decimator[channel];
+    
+    ADS1220_SNAPSHOT_LOCK();
+    float period_us = (rate_Hz > 0.0f) ? 1e6f / rate_Hz + 0.5f : 0.0f;
+    if (period_us > 4e9f) period_us = 4e9f;  // Límite de uint32_t en µs (~66 min)
+    dec.period_us = (uint32_t)period_us;
+    dec.count = 0;
+    dec.head = 0;
+    dec.pending = 0;
+    ADS1220_SNAPSHOT_UNLOCK();
+}
+
+uint8_t ADS1220_NTC_Extended::availableDecimated(ADS1220_Channel channel) {
+    return _decimator[channel].pending;
+}
+
+bool ADS1220_NTC_Extended::readDecimated(ADS1220_Channel channel, ADS1220_Sample &sample) {
+    Decimator &dec = _decimator[channel];
+    
+    ADS1220_SNAPSHOT_LOCK();
+    bool ready = dec.pending != 0;
+    if (ready) {
+        uint8_t tail = (uint8_t)((dec.head + ADS1220_DECIMATED_BUFFER_SIZE - dec.pending) % ADS1220_DECIMATED_BUFFER_SIZE);
+        sample = dec.out[tail];
+        dec.pending--;
+    }
+    ADS1220_SNAPSHOT_UNLOCK();
+    return ready;
+}
+
+void ADS1220_NTC_Extended::_decimate(uint8_t ch, const ADS1220_Sample &sample) {
+    Decimator &dec = _decimator[ch];
+    
+    ADS1220_SNAPSHOT_LOCK();
+    
+    // Bloque cumplido: se emite antes de añadir esta muestra, que abre el siguiente
+    if (dec.count > 0 && (sample.timestamp - dec.firstTimestamp) >= dec.period_us) {
+        ADS1220_Sample &out = dec.out[dec.head];
+        out.timestamp = dec.firstTimestamp + (dec.lastTimestamp - dec.firstTimestamp) / 2;
+        out.raw = (int32_t)(dec.rawSum / dec.count);
+        out.value = dec.mean;
+        out.channel = ch;
+        out.flags = dec.flags;
+        
+        dec.head = (uint8_t)((dec.head + 1) % ADS1220_DECIMATED_BUFFER_SIZE);
+        if (dec.pending < ADS1220_DECIMATED_BUFFER_SIZE) {
+            dec.pending++;
+        } else {
+            dec.out[dec.head].flags |= ADS1220_SAMPLE_OVERRUN;
+        }
+        dec.count = 0;
+    }
+    
+    if (dec.count == 0) {
+        dec.firstTimestamp = sample.timestamp;
+        dec.rawSum = 0;
+        dec.mean = 0.0f;
+        dec.flags = 0;
+    }
+    dec.count++;
+    dec.rawSum += sample.raw;
+    dec.mean += (sample.value - dec.mean) / (float)dec.count;
+    dec.flags |= sample.flags & ~ADS1220_SAMPLE_OVERRUN;
+    dec.lastTimestamp = sample.timestamp;
+    
+    ADS1220_SNAPSHOT_UNLOCK();
+}
+
+#else // ADS1220_DECIMATION == 0
+
+// Flujos diezmados deshabilitados en compilación
+void ADS1220_NTC_Extended::setDecimatedRate(ADS1220_Channel, float) {
+}
+
+uint8_t ADS1220_NTC_Extended::availableDecimated(ADS1220_Channel) {
+    return 0;
+}
+
+bool ADS1220_NTC_Extended::readDecimated(ADS1220_Channel, ADS1220_Sample &) {
+    return false;
+}
+
+#endif // ADS1220_DECIMATION
+
+// =============================================================================
+// INFORME POR EVENTOS
+// =============================================================================
+
+#if ADS1220_EVENT_REPORTING
+
+void ADS1220_NTC_Extended::setEventReporting(ADS1220_Channel channel, float deadband, float relativeDeadband,
+                                             uint32_t maxSilence_ms) {
+    EventReporter &ev = _events[channel];
+    ev.deadband = fabs(deadband);
+    ev.relative = fabs(relativeDeadband);
+    if (maxSilence_ms > 4000000UL) maxSilence_ms = 4000000UL;  // Límite de uint32_t en µs
+    ev.maxSilence_us = maxSilence_ms * 1000UL;
+    ev.suppressed = 0;
+    ev.primed = false;
+    ev.enabled = true;
+}
+
+void ADS1220_NTC_Extended::disableEventReporting(ADS1220_Channel channel) {
+    _events[channel].enabled = false;
+}
+
+void ADS1220_NTC_Extended::setEventCallback(ADS1220_EventCallback callback, void* context) {
+    ADS1220_SNAPSHOT_LOCK();
+    _eventCallback = callback;
+    _eventContext = context;
+    ADS1220_SNAPSHOT_UNLOCK();
+}
+
+uint8_t ADS1220_NTC_Extended::availableEvents() {
+    return _eventCount;
+}
+
+bool ADS1220_NTC_Extended::readEvent(ADS1220_Sample &event) {
+    ADS1220_SNAPSHOT_LOCK();
+    bool ready = _eventCount != 0;
+    if (ready) {
+        uint8_t tail = (uint8_t)((_eventHead + ADS1220_EVENT_BUFFER_SIZE - _eventCount) % ADS1220_EVENT_BUFFER_SIZE);
+        event = _eventQueue[tail];
+        _eventCount--;
+    }
+    ADS1220_SNAPSHOT_UNLOCK();
+    return ready;
+}
+
+uint32_t ADS1220_NTC_Extended::getSuppressedSamples(ADS1220_Channel channel) {
+    return _events[channel].suppressed;
+}
+
+void ADS1220_NTC_Extended::_reportEvent(uint8_t ch, const ADS1220_Sample &sample) {
+    EventReporter &ev = _events[ch];
+    bool valid = (sample.flags & ADS1220_SAMPLE_VALUE_VALID) != 0;
+    bool fault = (sample.flags & ADS1220_SAMPLE_SENSOR_FAULT) != 0;
+    float value = _stageValue[ch];
+    
+    // Primera muestra o cambio de estado de fallo: siempre se emite
+    bool emit = !ev.primed || fault != ev.lastFault;
+    
+    // Banda muerta respecto del último valor emitido (no de la muestra
+    // anterior): una deriva lenta se emite al acumular la banda
+    if (!emit && valid) {
+        float band = ev.relative * fabs(ev.lastValue);
+        if (band < ev.deadband) {
+            band = ev.deadband;
+        }
+        emit = fabs(value - ev.lastValue) > band;
+    }
+    if (!emit && ev.maxSilence_us != 0) {
+        emit = (sample.timestamp - ev.lastTimestamp) >= ev.maxSilence_us;
+    }
+    if (!emit) {
+        ev.suppressed++;
+        return;
+    }
+    
+    ev.primed = true;
+    ev.lastFault = fault;
+    ev.lastTimestamp = sample.timestamp;
+    if (valid) {
+        ev.lastValue = value;
+    }
+    
+    ADS1220_Sample event = sample;
+    if (valid) {
+        event.value = value;
+    }
+    
+    if (_eventCallback != nullptr) {
+        _eventCallback(event, _eventContext);
+        return;
+    }
+    
+    ADS1220_SNAPSHOT_LOCK();
+    _eventQueue[_eventHead] = event;
+    _eventHead = (uint8_t)((_eventHead + 1) % ADS1220_EVENT_BUFFER_SIZE);
+    if (_eventCount < ADS1220_EVENT_BUFFER_SIZE) {
+        _eventCount++;
+    } else {
+        _eventQueue[_eventHead].flags |= ADS1220_SAMPLE_OVERRUN;
+    }
+    ADS1220_SNAPSHOT_UNLOCK();
+}
+
+#else // ADS1220_EVENT_REPORTING == 0
+
+// Informe por eventos deshabilitado en compilación
+void ADS1220_NTC_Extended::setEventReporting(ADS1220_Channel, float, float, uint32_t) {
+}
+
+void ADS1220_NTC_Extended::disableEventReporting(ADS1220_Channel) {
+}
+
+void ADS1220_NTC_Extended::setEventCallback(ADS1220_EventCallback, void*) {
+}
+
+uint8_t ADS1220_NTC_Extended::availableEvents() {
+    return 0;
+}
+
+bool ADS1220_NTC_Extended::readEvent(ADS1220_Sample &) {
+    return false;
+}
+
+uint32_t ADS1220_NTC_Extended::getSuppressedSamples(ADS1220_Channel) {
+    return 0;
+}
+
+#endif // ADS1220_EVENT_REPORTING
+
+// =============================================================================
+// COMPENSACIÓN DE RESPUESTA DINÁMICA
+// =============================================================================
+
+#if ADS1220_RESPONSE_COMPENSATION
+
+void ADS1220_NTC_Extended::setResponseCompensation(ADS1220_Channel channel, float tau1_s, float tau2_s, float maxGain) {
+    _compensator[channel].configure(tau1_s, tau2_s, maxGain);
+    _compensator[channel].reset();
+}
+
+void ADS1220_NTC_Extended::startResponseIdentification(ADS1220_Channel channel, float stepThreshold) {
+    _compensator[channel].reset();
+    _compensator[channel].startIdentification(stepThreshold);
+}
+
+bool ADS1220_NTC_Extended::isIdentifyingResponse(ADS1220_Channel channel) {
+    return _compensator[channel].isIdentifying();
+}
+
+float ADS1220_NTC_Extended::getResponseTimeConstant(ADS1220_Channel channel, uint8_t stage) {
+    return _compensator[channel].getTimeConstant(stage);
+}
+
+#else // ADS1220_RESPONSE_COMPENSATION == 0
+
+// Compensador deshabilitado en compilación: las lecturas pasan sin compensar
+void ADS1220_NTC_Extended::setResponseCompensation(ADS1220_Channel, float, float, float) {
+}
+
+void ADS1220_NTC_Extended::startResponseIdentification(ADS1220_Channel, float) {
+}
+
+bool ADS1220_NTC_Extended::isIdentifyingResponse(ADS1220_Channel) {
+    return false;
+}
+
+float ADS1220_NTC_Extended::getResponseTimeConstant(ADS1220_Channel, uint8_t) {
+    return 0.0f;
+}
+
+#endif // ADS1220_RESPONSE_COMPENSATION
+
+bool ADS1220_NTC_Extended::_stageActive(ADS1220_Channel channel) {
+#if ADS1220_RESPONSE_COMPENSATION
+    if (_compensator[channel].isEnabled() || _compensator[channel].isIdentifying()) {
+        return true;
+    }
+#endif
+#if ADS1220_EVENT_REPORTING
+    if (_events[channel].enabled) {
+        return true;
+    }
+#endif
+    return _controlsChannel(channel);
+}
+
+float ADS1220_NTC_Extended::_filterStage(ADS1220_Channel channel, float value, uint32_t dt_us) {
+    // Promedio móvil primero (ruido) y luego el adelanto (dinámica del sensor)
+    value = updateMovingAverage(channel, value);
+#if ADS1220_RESPONSE_COMPENSATION
+    value = _compensator[channel].update(value, dt_us);
+#else
+    (void)dt_us;
+#endif
+    return value;
+}
+
+// =============================================================================
+// CONTROL PID DE PELTIER
+// =============================================================================
+
+#if ADS1220_PELTIER_CONTROL
+
+void ADS1220_NTC_Extended::beginPeltierControl(ADS1220_Channel channel, uint8_t pwmPin, uint8_t dirPin) {
+    enablePeltierControl(false);
+    
+    _controlChannel = channel;
+    _pwmPin = pwmPin;
+    _dirPin = dirPin;
+    
+#if defined(ESP32)
+    _init_pwm_esp32();
+#else
+    _init_pwm_arduino();
+#endif
+    
+    if (_dirPin != 255) {
+        pinMode(_dirPin, OUTPUT);
+        _pid.setOutputLimits(-1.0f, 1.0f);
+    } else {
+        _pid.setOutputLimits(0.0f, 1.0f);
+    }
+    _writePWM(0);
+}
+
+void ADS1220_NTC_Extended::setPIDGains(float kp, float ki, float kd) {
+    _pid.setGains(kp, ki, kd);
+}
+
+void ADS1220_NTC_Extended::setPIDSetpoint(float setpoint) {
+    _pid.setSetpoint(setpoint);
+}
+
+void ADS1220_NTC_Extended::setPIDOutputLimits(float minOutput, float maxOutput) {
+    if (_dirPin == 255 && minOutput < 0.0f) {
+        minOutput = 0.0f;  // Sin puente H no hay salida negativa
+    }
+    _pid.setOutputLimits(minOutput, maxOutput);
+}
+
+void ADS1220_NTC_Extended::enablePeltierControl(bool enable) {
+    if (_pwmPin == 255) {
+        return;  // Falta beginPeltierControl()
+    }
+    if (enable && !_controlEnabled) {
+        // Arranque sin golpe: integrador y derivada desde cero
+        _pid.reset();
+    }
+    if (!enable) {
+        _writePWM(0);
+    }
+    _controlEnabled = enable;
+}
+
+bool ADS1220_NTC_Extended::isPeltierControlEnabled() {
+    return _controlEnabled;
+}
+
+float ADS1220_NTC_Extended::getPIDOutput() {
+    return _pid.getOutput();
 }
 
-bool ADS1220_NTC_Extended::testCommunication() {
-    uint8_t reg0 = readRegister(ADS1220_REG0);
+uint32_t ADS1220_NTC_Extended::getControlLatency_us() {
+    return _controlLatency_us;
+}
+
+uint32_t ADS1220_NTC_Extended::getMaxControlLatency_us() {
+    return _controlMaxLatency_us;
+}
+
+uint32_t ADS1220_NTC_Extended::getControlUpdates() {
+    return _controlUpdates;
+}
+
+void ADS1220_NTC_Extended::resetControlStatistics() {
+    _controlLatency_us = 0;
+    _controlMaxLatency_us = 0;
+    _controlUpdates = 0;
+}
+
+void ADS1220_NTC_Extended::_controlUpdate(const ADS1220_Sample &sample, uint32_t dt_us) {
+    // dt real entre muestras del canal (el primero solo inicializa el PID)
+    _pid.update(_stageValue[_controlChannel], dt_us);
+    _controlUpdates++;
     
-    if (reg0 == 0xFF) {
-        return false;
+    // Al reprocesar una grabación el PID corre, pero la Peltier no se mueve
+    if (_replaying) {
+        return;
     }
     
-    uint8_t originalValue = reg0;
-    writeRegister(ADS1220_REG0, 0xAA);
-    delayMicroseconds(100);
-    
-    uint8_t readback = readRegister(ADS1220_REG0);
-    
-    writeRegister(ADS1220_REG0, originalValue);
-    delayMicroseconds(100);
+    _writePWM(_pid.getOutputScaled(_pwmMax));
     
-    return (readback == 0xAA);
+    _controlLatency_us = micros() - sample.timestamp;
+    if (_controlLatency_us > _controlMaxLatency_us) {
+        _controlMaxLatency_us = _controlLatency_us;
+    }
 }
 
+void ADS1220_NTC_Extended::_writePWM(int32_t duty) {
+    if (_dirPin != 255) {
+        digitalWrite(_dirPin, (duty < 0) ? LOW : HIGH);
+    }
+    if (duty < 0) duty = -duty;
+    if (duty > _pwmMax) duty = _pwmMax;
+    
+#if defined(ESP32)
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+    ledcWrite(_pwmPin, (uint32_t)duty);
+#else
+    ledcWrite(ADS1220_PWM_LEDC_CHANNEL, (uint32_t)duty);
+#endif
+#else
+    analogWrite(_pwmPin, (int)duty);
+#endif
+}
+
+void ADS1220_NTC_Extended::_init_pwm_arduino() {
+    // analogWrite(): 8 bits a la frecuencia fija del timer (~490/980 Hz en AVR)
+    pinMode(_pwmPin, OUTPUT);
+    _pwmMax = 255;
+}
+
+void ADS1220_NTC_Extended::_init_pwm_esp32() {
+#if defined(ESP32)
+    // LEDC: frecuencia fuera del rango audible para la Peltier
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+    ledcAttach(_pwmPin, ADS1220_PWM_FREQUENCY, ADS1220_PWM_RESOLUTION);
+#else
+    ledcSetup(ADS1220_PWM_LEDC_CHANNEL, ADS1220_PWM_FREQUENCY, ADS1220_PWM_RESOLUTION);
+    ledcAttachPin(_pwmPin, ADS1220_PWM_LEDC_CHANNEL);
+#endif
+    _pwmMax = (uint16_t)((1UL << ADS1220_PWM_RESOLUTION) - 1);
+#else
+    _init_pwm_arduino();
+#endif
+}
+
+#else // ADS1220_PELTIER_CONTROL == 0
+
+// Control PID deshabilitado en compilación: la Peltier no se configura
+void ADS1220_NTC_Extended::beginPeltierControl(ADS1220_Channel, uint8_t, uint8_t) {
+}
+
+void ADS1220_NTC_Extended::setPIDGains(float, float, float) {
+}
+
+void ADS1220_NTC_Extended::setPIDSetpoint(float) {
+}
+
+void ADS1220_NTC_Extended::setPIDOutputLimits(float, float) {
+}
+
+void ADS1220_NTC_Extended::enablePeltierControl(bool) {
+}
+
+bool ADS1220_NTC_Extended::isPeltierControlEnabled() {
+    return false;
+}
+
+float ADS1220_NTC_Extended::getPIDOutput() {
+    return 0.0f;
+}
+
+uint32_t ADS1220_NTC_Extended::getControlLatency_us() {
+    return 0;
+}
+
+uint32_t ADS1220_NTC_Extended::getMaxControlLatency_us() {
+    return 0;
+}
+
+uint32_t ADS1220_NTC_Extended::getControlUpdates() {
+    return 0;
+}
+
+void ADS1220_NTC_Extended::resetControlStatistics() {
+}
+
+#endif // ADS1220_PELTIER_CONTROL
+
 // =============================================================================
 // FUNCIONES PRIVADAS SPI
 // =============================================================================
 
 void ADS1220_NTC_Extended::sendCommand(uint8_t cmd) {
-    _spi->beginTransaction(SPISettings(1000000, MSBFIRST, SPI_MODE1));
-    csLow();
-    _spi->transfer(cmd);
-    csHigh();
-    _spi->endTransaction();
+    _transport->transfer(&cmd, nullptr, 1);
 }
 
 uint8_t ADS1220_NTC_Extended::readRegister(uint8_t reg) {
-    _spi->beginTransaction(SPISettings(1000000, MSBFIRST, SPI_MODE1));
-    csLow();
-    
-    _spi->transfer(ADS1220_CMD_RREG | ((reg & 0x03) << 2));
-    uint8_t value = _spi->transfer(0x00);
-    
-    csHigh();
-    _spi->endTransaction();
+    uint8_t buffer[2] = {(uint8_t)(ADS1220_CMD_RREG | ((reg & 0x03) << 2)), 0x00};
+    _transport->transfer(buffer, buffer, 2);
+    return buffer[1];
+}
+
+void ADS1220_NTC_Extended::readRegisters(uint8_t firstReg, uint8_t count, uint8_t* values) {
+    // RREG en ráfaga: un solo ciclo de CS para varios registros
+    uint8_t buffer[5] = {0x00, 0x00, 0x00, 0x00, 0x00};
     
-    return value;
+    firstReg &= 0x03;
+    if (count == 0 || firstReg + count > 4) {
+        return;
+    }
+    buffer[0] = ADS1220_CMD_RREG | (firstReg << 2) | (count - 1);
+    _transport->transfer(buffer, buffer, count + 1);
+    for (uint8_t i = 0; i < count; i++) {
+        values[i] = buffer[1 + i];
+    }
 }
 
 void ADS1220_NTC_Extended::writeRegister(uint8_t reg, uint8_t value) {
-    _spi->beginTransaction(SPISettings(1000000, MSBFIRST, SPI_MODE1));
-    csLow();
-    
-    _spi->transfer(ADS1220_CMD_WREG | ((reg & 0x03) << 2));
-    _spi->transfer(value);
-    
-    csHigh();
-    _spi->endTransaction();
+    uint8_t buffer[2] = {(uint8_t)(ADS1220_CMD_WREG | ((reg & 0x03) << 2)), value};
+    _transport->transfer(buffer, nullptr, 2);
+}
+
+void ADS1220_NTC_Extended::writeRegisters(uint8_t firstReg, uint8_t count) {
+    // WREG en ráfaga desde la copia shadow: un solo ciclo de CS
+    const uint8_t shadow[4] = {_reg0, _reg1, _reg2, _reg3};
+    uint8_t buffer[5];
     
-    delayMicroseconds(50);
+    firstReg &= 0x03;
+    if (count == 0 || firstReg + count > 4) {
+        return;
+    }
+    buffer[0] = ADS1220_CMD_WREG | (firstReg << 2) | (count - 1);
+    for (uint8_t i = 0; i < count; i++) {
+        buffer[1 + i] = shadow[firstReg + i];
+    }
+    _transport->transfer(buffer, nullptr, count + 1);
 }
 
 int32_t ADS1220_NTC_Extended::readConversionData() {
-    _spi->beginTransaction(SPISettings(1000000, MSBFIRST, SPI_MODE1));
-    csLow();
-    
-    _spi->transfer(ADS1220_CMD_RDATA);
-    
-    uint8_t msb = _spi->transfer(0x00);
-    uint8_t mid = _spi->transfer(0x00);
-    uint8_t lsb = _spi->transfer(0x00);
+    uint8_t buffer[4] = {ADS1220_CMD_RDATA, 0x00, 0x00, 0x00};
+    _transport->transfer(buffer, buffer, 4);
     
-    csHigh();
-    _spi->endTransaction();
+    uint8_t msb = buffer[1];
+    uint8_t mid = buffer[2];
+    uint8_t lsb = buffer[3];
     
     int32_t result = ((uint32_t)msb << 16) | ((uint32_t)mid << 8) | (uint32_t)lsb;
     
@@ -624,9 +2567,6 @@ void ADS1220_NTC_Extended::configureChannel(ADS1220_Channel channel) {
     uint8_t muxSetting = (channel == CHANNEL_0) ? ADS1220_MUX_AIN0_AIN1 : ADS1220_MUX_AIN2_AIN3;
     
     _reg0 = (_reg0 & 0x0F) | muxSetting;
-    writeRegister(ADS1220_REG0, _reg0);
-    
-    delay(10);
 }
 
 void ADS1220_NTC_Extended::configureIDAC(ADS1220_Channel channel) {
@@ -634,19 +2574,295 @@ void ADS1220_NTC_Extended::configureIDAC(ADS1220_Channel channel) {
     
     if (_channelMode[ch] == MODE_NTC) {
         uint8_t idac_setting = _getCurrentRegisterSetting(_idacCurrent * 1e6f);
-        _reg2 = (_reg2 & 0xF8) | idac_setting;
-        writeRegister(ADS1220_REG2, _reg2);
+        uint8_t vref = (_refResistance[ch] > 0.0f) ? ADS1220_VREF_REFP0 : ADS1220_VREF_INTERNAL;
+        _reg2 = (_reg2 & 0x38) | vref | idac_setting;
         
         if (channel == CHANNEL_0) {
             _reg3 = (_reg3 & 0x1F) | (ADS1220_IDAC_AIN0 << 5);
         } else {
             _reg3 = (_reg3 & 0xE3) | (ADS1220_IDAC_AIN2 << 2);
         }
-        writeRegister(ADS1220_REG3, _reg3);
     } else {
-        _reg2 = (_reg2 & 0xF8) | ADS1220_IDAC_OFF;
-        writeRegister(ADS1220_REG2, _reg2);
+        _reg2 = (_reg2 & 0x38) | ADS1220_VREF_INTERNAL | ADS1220_IDAC_OFF;
+    }
+}
+
+bool ADS1220_NTC_Extended::_measureShortedInput(uint8_t samples, int32_t &offset) {
+    // MUX = (AVDD + AVSS)/2 en ambas entradas; ganancia y PGA sin cambios
+    _reg0 = (_reg0 & 0x0F) | ADS1220_MUX_SHORTED;
+    writeRegister(ADS1220_REG0, _reg0);
+    
+    uint32_t settleStart = micros();
+    while (micros() - settleStart < _settleTime_us) {
+        yield();
+    }
+    
+    // La primera conversión tras el cambio de MUX se descarta
+    int32_t code;
+    if (!_convertBlocking(code)) {
+        return false;
+    }
+    
+    int32_t sum = 0;
+    for (uint8_t i = 0; i < samples; i++) {
+        if (!_convertBlocking(code)) {
+            return false;
+        }
+        sum += code;
+    }
+    
+    // Promedio redondeado y saturado al rango de la tabla (int16_t)
+    int32_t half = (sum >= 0) ? (samples / 2) : -(int32_t)(samples / 2);
+    offset = (sum + half) / (int32_t)samples;
+    if (offset > 32767) offset = 32767;
+    if (offset < -32768) offset = -32768;
+    return true;
+}
+
+int32_t ADS1220_NTC_Extended::_applyOffset(int32_t rawValue) {
+    uint8_t gainIndex = (_reg0 >> 1) & 0x07;
+    if (_offsetCorrection && (_offsetValid & (1 << gainIndex))) {
+        rawValue -= _offsetTable[gainIndex];
+    }
+    return rawValue;
+}
+
+uint8_t ADS1220_NTC_Extended::_offsetFlag() {
+    uint8_t gainIndex = (_reg0 >> 1) & 0x07;
+    if (_offsetCorrection && (_offsetValid & (1 << gainIndex))) {
+        return ADS1220_SAMPLE_OFFSET_CORRECTED;
+    }
+    return 0;
+}
+
+void ADS1220_NTC_Extended::_updateBackgroundOffset(int32_t offset) {
+    if (offset > 32767) offset = 32767;
+    if (offset < -32768) offset = -32768;
+    
+    uint8_t gainIndex = (_reg0 >> 1) & 0x07;
+    if (_offsetValid & (1 << gainIndex)) {
+        // Filtro IIR (1/4) para no trasladar el ruido de una sola conversión
+        int32_t current = _offsetTable[gainIndex];
+        _offsetTable[gainIndex] = (int16_t)(current + (offset - current) / 4);
+    } else {
+        _offsetTable[gainIndex] = (int16_t)offset;
+        _offsetValid |= (1 << gainIndex);
+    }
+}
+
+void ADS1220_NTC_Extended::_beginPhase(ReadPhase phase) {
+    _readPhase = phase;
+    
+    switch (phase) {
+        case PHASE_OFFSET:
+            // MUX = (AVDD + AVSS)/2 en ambas entradas; ganancia y PGA sin cambios
+            _reg0 = (_reg0 & 0x0F) | ADS1220_MUX_SHORTED;
+            writeRegister(ADS1220_REG0, _reg0);
+            break;
+            
+        case PHASE_DIAG:
+            {
+                // Fuentes de burnout con IDAC apagado, referencia interna y PGA
+                // en bypass (admite entradas en los raíles). Los shadow no
+                // cambian: PHASE_MAIN reescribe los cuatro registros después
+                uint8_t mux = (_readChannel == CHANNEL_0) ? ADS1220_MUX_AIN0_AIN1 : ADS1220_MUX_AIN2_AIN3;
+                const uint8_t buffer[5] = {
+                    ADS1220_CMD_WREG | (ADS1220_REG0 << 2) | 3,
+                    (uint8_t)(mux | ADS1220_GAIN_1 | ADS1220_PGA_BYPASSED),
+                    (uint8_t)(_reg1 | ADS1220_BCS_ON),
+                    (uint8_t)((_reg2 & 0x38) | ADS1220_VREF_INTERNAL | ADS1220_IDAC_OFF),
+                    _reg3
+                };
+                _transport->transfer(buffer, nullptr, 5);
+            }
+            break;
+            
+        case PHASE_MAIN:
+            // MUX, referencia e IDAC en una sola ráfaga WREG
+            configureChannel(_readChannel);
+            configureIDAC(_readChannel);
+            writeRegisters(ADS1220_REG0, 4);
+            break;
+            
+        case PHASE_CHOP_B:
+        default:
+            {
+                // MUX invertido y fuentes IDAC intercambiadas (mismos pines);
+                // _reg3 conserva el enrutamiento normal para restaurarlo
+                uint8_t reversedMux = (_readChannel == CHANNEL_0) ? ADS1220_MUX_AIN1_AIN0 : ADS1220_MUX_AIN3_AIN2;
+                _reg0 = (_reg0 & 0x0F) | reversedMux;
+                
+                const uint8_t writeReg0[2] = {ADS1220_CMD_WREG | (ADS1220_REG0 << 2), _reg0};
+                const uint8_t writeReg3[2] = {ADS1220_CMD_WREG | (ADS1220_REG3 << 2), _chopReg3()};
+                const ADS1220_Transaction queue[2] = {
+                    {writeReg0, nullptr, 2},
+                    {writeReg3, nullptr, 2}
+                };
+                _transport->transferQueue(queue, 2);
+            }
+            break;
+    }
+    
+    _phaseStart_us = micros();
+    _readState = STATE_SETTLING;
+}
+
+uint32_t ADS1220_NTC_Extended::_conversionTime_us() {
+    // Periodo nominal en modo normal para DR = 20, 45, 90, 175, 330, 600, 1000 SPS
+    static const uint16_t periods_us[8] = {50000, 22222, 11111, 5714, 3030, 1667, 1000, 1000};
+    
+    uint32_t period = periods_us[(_reg1 >> 5) & 0x07];
+    uint8_t mode = _reg1 & 0x18;
+    if (mode == ADS1220_MODE_TURBO) {
+        period /= 2;
+    } else if (mode == ADS1220_MODE_DUTY) {
+        period *= 4;
+    }
+    return period;
+}
+
+bool ADS1220_NTC_Extended::_conversionReady(uint32_t now) {
+    uint32_t elapsed = now - _phaseStart_us;
+    uint32_t period = _conversionTime_us();
+    
+    if (_drdyPin != 255) {
+        // Ignorar DRDY durante la primera mitad del periodo (dato anterior)
+        return (elapsed >= period / 2) && (digitalRead(_drdyPin) == LOW);
+    }
+    
+    if (_transport->hasDataReady()) {
+        return _transport->dataReady();
+    }
+    
+    // Sin DRDY: periodo + 12.5% + 100 µs de margen
+    return elapsed >= period + period / 8 + 100;
+}
+
+bool ADS1220_NTC_Extended::_convertBlocking(int32_t &code) {
+    // Misma espera que poll(): DRDY o periodo nominal con margen, nunca un
+    // retardo fijo (a 20 SPS RDATA devolvería la conversión anterior)
+    startConversion();
+    _phaseStart_us = micros();
+    while (!_conversionReady(micros())) {
+        if (micros() - _phaseStart_us > ADS1220_READ_TIMEOUT_US) {
+            return false;
+        }
+        yield();
+    }
+    code = readConversionData();
+    return true;
+}
+
+void ADS1220_NTC_Extended::_finishRead(int32_t rawValue, uint8_t flags, uint32_t timestamp,
+                                       ADS1220_Sample &sample) {
+    _readState = STATE_IDLE;
+    
+    uint8_t ch = (_readChannel == CHANNEL_0) ? 0 : 1;
+    _lastRawReading = rawValue;
+    _lastChannel = _readChannel;
+    
+    sample.timestamp = timestamp;
+    sample.raw = rawValue;
+    sample.channel = ch;
+    sample.value = _computeValue(ch, rawValue, flags);
+    
+    _rangeHealth[ch] = _checkRange(ch, rawValue, sample.value);
+#if ADS1220_SENSOR_DIAGNOSTICS
+    if (_diagSaturated & (1 << ch)) {
+        _diagSaturated &= (uint8_t)~(1 << ch);
+        _diagHealth[ch] = _saturatedDiagnostic(ch, rawValue);
+    }
+#endif
+    if (rawValue >= ADS1220_SATURATION_CODE || rawValue <= -ADS1220_SATURATION_CODE) {
+        flags &= ~ADS1220_SAMPLE_VALUE_VALID;  // Código saturado: el valor no es del sensor
+    }
+    if (getChannelHealth(_readChannel) > HEALTH_OK) {
+        flags |= ADS1220_SAMPLE_SENSOR_FAULT;
+    }
+#if ADS1220_SENSOR_DIAGNOSTICS
+    if (flags & ADS1220_SAMPLE_HEAT_FLUX) {
+        _diagSignal[ch] = rawToVoltage(rawValue);
+    }
+#endif
+    sample.flags = flags;
+    
+    _pushSample(sample);
+    
+#if ADS1220_DECIMATION
+    if ((flags & ADS1220_SAMPLE_VALUE_VALID) && _decimator[ch].period_us != 0) {
+        _decimate(ch, sample);
+    }
+#endif
+#if ADS1220_ENERGY_ACCUMULATOR
+    if ((flags & ADS1220_SAMPLE_HEAT_FLUX) && _energy[ch].enabled) {
+        if (flags & ADS1220_SAMPLE_VALUE_VALID) {
+            _accumulateEnergy(ch, sample);
+        } else {
+            _breakEnergy(ch);
+        }
+    }
+#endif
+#if ADS1220_STATISTICS
+    if ((flags & ADS1220_SAMPLE_VALUE_VALID) && _stats[ch].enabled) {
+        _updateStatistics(ch, sample);
+    }
+#endif
+    
+    if ((flags & ADS1220_SAMPLE_VALUE_VALID) && _stageActive(_readChannel)) {
+        uint32_t dt_us = sample.timestamp - _stageLast_us[ch];
+        _stageLast_us[ch] = sample.timestamp;
+        _stageValue[ch] = _filterStage(_readChannel, sample.value, dt_us);
+        
+#if ADS1220_PELTIER_CONTROL
+        if (_controlsChannel(_readChannel)) {
+            _controlUpdate(sample, dt_us);
+        }
+#endif
+    }
+    
+#if ADS1220_EVENT_REPORTING
+    if (_events[ch].enabled) {
+        _reportEvent(ch, sample);
+    }
+#endif
+}
+
+float ADS1220_NTC_Extended::_computeValue(uint8_t ch, int32_t rawValue, uint8_t &flags) {
+    float value;
+    
+    if (_channelMode[ch] == MODE_NTC) {
+        if (_modelEnabled[ch]) {
+            if (_modelDirty & (1 << ch)) {
+                _fitDirectModel(ch);
+            }
+            // Ruta directa: código -> T sin pasar por voltaje ni resistencia
+            if (!_evaluateDirectModel(ch, rawValue, value)) {
+                value = _chainTemperature(ch, rawValue);
+            }
+        } else {
+            value = _chainTemperature(ch, rawValue);
+        }
+    } else {
+        // φ = U / S(Ts)  [W/m²]
+        float S = _heatFluxCal[_cal(ch)].So + (_hfSensorTemp[ch] - _heatFluxCal[_cal(ch)].To) * _heatFluxCal[_cal(ch)].Sc;
+        value = rawToVoltage(rawValue) * 1e6f / S;
+        flags |= ADS1220_SAMPLE_HEAT_FLUX;
+    }
+    
+    flags |= ADS1220_SAMPLE_VALUE_VALID;
+    return value;
+}
+
+bool ADS1220_NTC_Extended::_readBlocking(ADS1220_Channel channel, ADS1220_Sample &sample) {
+    if (!startRead(channel)) {
+        return false;  // Hay una lectura no bloqueante en curso
     }
+    
+    ADS1220_ReadStatus status;
+    while ((status = poll(sample)) == READ_PENDING) {
+        yield();
+    }
+    return status == READ_READY;
 }
 
 uint8_t ADS1220_NTC_Extended::_getCurrentRegisterSetting(float desiredCurrent_uA) {
@@ -679,23 +2895,215 @@ float ADS1220_NTC_Extended::voltageToResistance(float voltage) {
     return voltage / _idacCurrent;
 }
 
+float ADS1220_NTC_Extended::rawToResistance(uint8_t ch, int32_t rawValue) {
+    if (_refResistance[ch] > 0.0f) {
+        // R_ntc = code × R_ref / (Gain × 2^23), con el factor precalculado
+        if (rawValue <= 0) {
+            return 0.0f;
+        }
+        return (float)rawValue * _ratioScale[ch];
+    }
+    return voltageToResistance(rawToVoltage(rawValue));
+}
+
+void ADS1220_NTC_Extended::_updateRatiometricScale() {
+    for (int ch = 0; ch < 2; ch++) {
+        _ratioScale[ch] = _refResistance[ch] / ((float)_currentGain * (float)ADS1220_MAX_CODE);
+    }
+    // La ganancia o R_ref cambiaron: el modelo directo debe reajustarse
+    _modelDirty = 0x03;
+}
+
 float ADS1220_NTC_Extended::resistanceToTemperature(float resistance) {
+    uint8_t ch = (_lastChannel == CHANNEL_0) ? 0 : 1;
+    return _steinhartHart(ch, resistance);
+}
+
+float ADS1220_NTC_Extended::_steinhartHart(uint8_t ch, float resistance) {
     if (resistance <= 0.0f) {
         return -999.0f;
     }
     
-    uint8_t ch = (_lastChannel == CHANNEL_0) ? 0 : 1;
-    
     float lnR = log(resistance);
     float lnR3 = lnR * lnR * lnR;
     
-    float invT = _ntc_A[ch] + (_ntc_B[ch] * lnR) + (_ntc_C[ch] * lnR3);
+    float invT = _ntc_A[_cal(ch)] + (_ntc_B[_cal(ch)] * lnR) + (_ntc_C[_cal(ch)] * lnR3);
     float tempKelvin = 1.0f / invT;
     float tempCelsius = tempKelvin - 273.15f;
     
     return tempCelsius;
 }
 
+float ADS1220_NTC_Extended::_chainTemperature(uint8_t ch, int32_t rawValue) {
+    return _steinhartHart(ch, rawToResistance(ch, rawValue));
+}
+
+// =============================================================================
+// MODELO DIRECTO (AJUSTE Y EVALUACIÓN)
+// =============================================================================
+
+#if ADS1220_MODEL_SEGMENTS > 0
+
+// floor(log2(code)) para code > 0, sin depender del tamaño de int/long
+static int8_t codeOctave(uint32_t code) {
+    int8_t n = 0;
+    if (code >= 0x10000UL) { code >>= 16; n += 16; }
+    if (code >= 0x100UL)   { code >>= 8;  n += 8; }
+    if (code >= 0x10UL)    { code >>= 4;  n += 4; }
+    if (code >= 0x4UL)     { code >>= 2;  n += 2; }
+    if (code >= 0x2UL)     { n += 1; }
+    return n;
+}
+
+static float cubeRoot(float value) {
+    return (value < 0.0f) ? -pow(-value, 1.0f / 3.0f) : pow(value, 1.0f / 3.0f);
+}
+
+int32_t ADS1220_NTC_Extended::_temperatureToCode(uint8_t ch, float temperature) {
+    // Inversa de Steinhart-Hart: resolver A + B·y + C·y³ = 1/T para y = ln(R)
+    float invT = 1.0f / (temperature + 273.15f);
+    float lnR;
+    if (_ntc_C[_cal(ch)] == 0.0f) {
+        lnR = (invT - _ntc_A[_cal(ch)]) / _ntc_B[_cal(ch)];
+    } else {
+        float x = (_ntc_A[_cal(ch)] - invT) / _ntc_C[_cal(ch)];
+        float b3c = _ntc_B[_cal(ch)] / (3.0f * _ntc_C[_cal(ch)]);
+        float y = sqrt(b3c * b3c * b3c + 0.25f * x * x);
+        lnR = cubeRoot(y - 0.5f * x) - cubeRoot(y + 0.5f * x);
+    }
+    float resistance = exp(lnR);
+    
+    float code;
+    if (_refResistance[ch] > 0.0f) {
+        code = resistance / _ratioScale[ch];
+    } else {
+        code = resistance * _idacCurrent * (float)_currentGain * (float)ADS1220_MAX_CODE / ADS1220_VREF;
+    }
+    
+    if (!(code > 0.0f)) return 0;
+    if (code > (float)ADS1220_MAX_CODE) return ADS1220_MAX_CODE;
+    return (int32_t)code;
+}
+
+void ADS1220_NTC_Extended::_fitDirectModel(uint8_t ch) {
+    _modelDirty &= ~(1 << ch);
+    _modelSegments[ch] = 0;
+    
+    if (_refResistance[ch] <= 0.0f && _idacCurrent <= 0.0f) {
+        return;
+    }
+    
+    // NTC: mayor temperatura -> menor resistencia -> menor código
+    int32_t codeLow = _temperatureToCode(ch, _modelMaxTemp[ch]);
+    int32_t codeHigh = _temperatureToCode(ch, _modelMinTemp[ch]);
+    if (codeLow < 64) codeLow = 64;  // Tramos de al menos 8 códigos de ancho
+    if (codeHigh <= codeLow) {
+        return;
+    }
+    
+    int8_t firstOctave = codeOctave((uint32_t)codeLow);
+    uint8_t octaves = codeOctave((uint32_t)codeHigh) - firstOctave + 1;
+    
+    // Repartir los tramos disponibles: hasta 8 por octava
+    uint8_t subBits = 0;
+    while (subBits < 3 && (octaves << (subBits + 1)) <= ADS1220_MODEL_SEGMENTS) {
+        subBits++;
+    }
+    if (octaves > ADS1220_MODEL_SEGMENTS) {
+        octaves = ADS1220_MODEL_SEGMENTS;
+    }
+    uint8_t segments = octaves << subBits;
+    
+    for (uint8_t seg = 0; seg < segments; seg++) {
+        int8_t octave = firstOctave + (seg >> subBits);
+        uint8_t sub = seg & ((1 << subBits) - 1);
+        int32_t width = (int32_t)1 << (octave - subBits);
+        int32_t lo = ((int32_t)1 << octave) + (int32_t)sub * width;
+        
+        // Variable del tramo: w = k·(code - lo)/(code + lo) en [0, 1), con
+        // k = 2·(lo/width) + 1. Como ln(code/lo) = 2·atanh((code - lo)/(code + lo)),
+        // T(w) es casi lineal y un cúbico la aproxima con error despreciable.
+        int32_t k = 2 * (((int32_t)1 << subBits) + sub) + 1;
+        
+        // Interpolación en 4 nodos de Chebyshev dentro de [0, 1)
+        float xn[4], tn[4];
+        for (uint8_t i = 0; i < 4; i++) {
+            float node = 0.5f - 0.5f * cos((2 * i + 1) * PI / 8.0f);
+            float z = node / (float)k;
+            int32_t code = (int32_t)((float)lo * (1.0f + z) / (1.0f - z) + 0.5f);
+            if (code > ADS1220_MAX_CODE) code = ADS1220_MAX_CODE;
+            xn[i] = (float)((code - lo) * k) / (float)(code + lo);
+            tn[i] = _chainTemperature(ch, code);
+        }
+        
+        // Diferencias divididas de Newton
+        float d1 = (tn[1] - tn[0]) / (xn[1] - xn[0]);
+        float d2 = (tn[2] - tn[1]) / (xn[2] - xn[1]);
+        float d3 = (tn[3] - tn[2]) / (xn[3] - xn[2]);
+        float e1 = (d2 - d1) / (xn[2] - xn[0]);
+        float e2 = (d3 - d2) / (xn[3] - xn[1]);
+        float f1 = (e2 - e1) / (xn[3] - xn[0]);
+        
+        // Forma de Newton -> coeficientes monomiales (Horner)
+        // p(x) = t0 + d1(x-x0) + e1(x-x0)(x-x1) + f1(x-x0)(x-x1)(x-x2)
+        float x0 = xn[0], x1 = xn[1], x2 = xn[2];
+        ModelSegment &m = _model[ch][seg];
+        m.c3 = f1;
+        m.c2 = e1 - f1 * (x0 + x1 + x2);
+        m.c1 = d1 - e1 * (x0 + x1) + f1 * (x0 * x1 + x0 * x2 + x1 * x2);
+        m.c0 = tn[0] - d1 * x0 + e1 * x0 * x1 - f1 * x0 * x1 * x2;
+    }
+    
+    _modelFirstOctave[ch] = firstOctave;
+    _modelSubBits[ch] = subBits;
+    _modelSegments[ch] = segments;
+}
+
+bool ADS1220_NTC_Extended::_evaluateDirectModel(uint8_t ch, int32_t rawValue, float &temperature) {
+    if (rawValue <= 0) {
+        return false;
+    }
+    
+    int8_t octave = codeOctave((uint32_t)rawValue);
+    int8_t relOctave = octave - _modelFirstOctave[ch];
+    if (relOctave < 0) {
+        return false;
+    }
+    
+    uint8_t subBits = _modelSubBits[ch];
+    uint8_t shift = octave - subBits;
+    uint16_t seg = ((uint16_t)relOctave << subBits) | ((rawValue >> shift) & ((1 << subBits) - 1));
+    if (seg >= _modelSegments[ch]) {
+        return false;
+    }
+    
+    // w = k·(code - lo)/(code + lo), igual que en _fitDirectModel()
+    int32_t lo = rawValue & ~(((int32_t)1 << shift) - 1);
+    int32_t k = 2 * (int32_t)(lo >> shift) + 1;
+    float w = (float)((rawValue - lo) * k) / (float)(rawValue + lo);
+    const ModelSegment &m = _model[ch][seg];
+    temperature = m.c0 + w * (m.c1 + w * (m.c2 + w * m.c3));
+    return true;
+}
+
+#else // ADS1220_MODEL_SEGMENTS == 0
+
+// Modelo directo deshabilitado en compilación: siempre se usa la cadena completa
+int32_t ADS1220_NTC_Extended::_temperatureToCode(uint8_t, float) {
+    return 0;
+}
+
+void ADS1220_NTC_Extended::_fitDirectModel(uint8_t ch) {
+    _modelDirty &= ~(1 << ch);
+    _modelSegments[ch] = 0;
+}
+
+bool ADS1220_NTC_Extended::_evaluateDirectModel(uint8_t, int32_t, float &) {
+    return false;
+}
+
+#endif // ADS1220_MODEL_SEGMENTS
+
 // =============================================================================
 // CÁLCULOS HEAT FLUX
 // =============================================================================
@@ -715,7 +3123,13 @@ float ADS1220_NTC_Extended::heatFluxToThermalPower(float heatFlux, float sensorA
 float ADS1220_NTC_Extended::updateMovingAverage(ADS1220_Channel channel, float newValue) {
     uint8_t ch = (channel == CHANNEL_0) ? 0 : 1;
     
-    _tempBuffer[ch][_bufferIndex[ch]] = newValue;
+    // Sin buffer (ADS1220_MAX_AVG_SIZE = 0 y sin arena): sin promediar
+    if (_filterCapacity == 0) {
+        return newValue;
+    }
+    
+    float* buffer = _filterBuffer + (uint16_t)ch * _filterCapacity;
+    buffer[_bufferIndex[ch]] = newValue;
     _bufferIndex[ch]++;
     
     if (_bufferIndex[ch] >= _avgSize) {
@@ -727,37 +3141,12 @@ float ADS1220_NTC_Extended::updateMovingAverage(ADS1220_Channel channel, float n
     uint8_t count = _bufferFull[ch] ? _avgSize : _bufferIndex[ch];
     
     for (uint8_t i = 0; i < count; i++) {
-        sum += _tempBuffer[ch][i];
+        sum += buffer[i];
     }
     
     return sum / (float)count;
 }
 
-void ADS1220_NTC_Extended::csLow() {
-    digitalWrite(_csPin, LOW);
-    delayMicroseconds(1);
-}
-
-void ADS1220_NTC_Extended::csHigh() {
-    delayMicroseconds(1);
-    digitalWrite(_csPin, HIGH);
-}
-
-bool ADS1220_NTC_Extended::waitForData(uint16_t timeout_ms) {
-    if (_drdyPin != 255) {
-        uint32_t startTime = millis();
-        while (digitalRead(_drdyPin) == HIGH) {
-            if (millis() - startTime > timeout_ms) {
-                return false;
-            }
-            delay(1);
-        }
-        return true;
-    }
-    
-    delay(15);  // Para 90 SPS: ~11ms por conversión
-    return true;
-}
 
 
 
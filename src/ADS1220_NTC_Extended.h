@@ -29,6 +29,11 @@
 
 #include <Arduino.h>
 #include <SPI.h>
+#include "ADS1220_Protocol.h"
+#include "ADS1220_SPITransport.h"
+#include "ADS1220_PID.h"
+#include "ADS1220_Compensator.h"
+#include "ADS1220_Config.h"
 
 // ===== COMANDOS SPI DEL ADS1220 =====
 #define ADS1220_CMD_RESET       0x06
@@ -54,6 +59,13 @@
 #define ADS1220_MUX_AIN2_AIN3   0x50
 #define ADS1220_MUX_AIN1_AIN0   0x60
 #define ADS1220_MUX_AIN3_AIN2   0x70
+#define ADS1220_MUX_AIN0_AVSS   0x80
+#define ADS1220_MUX_AIN1_AVSS   0x90
+#define ADS1220_MUX_AIN2_AVSS   0xA0
+#define ADS1220_MUX_AIN3_AVSS   0xB0
+#define ADS1220_MUX_REF_DIV4    0xC0    // (VREFPx - VREFNx) / 4
+#define ADS1220_MUX_AVDD_DIV4   0xD0    // (AVDD - AVSS) / 4
+#define ADS1220_MUX_SHORTED     0xE0    // Entradas en corto a (AVDD + AVSS) / 2
 
 // Configuración de GANANCIA (Registro 0, bits 3:1)
 #define ADS1220_GAIN_1          0x00
@@ -87,6 +99,10 @@
 #define ADS1220_CM_SINGLE       0x00
 #define ADS1220_CM_CONTINUOUS   0x04
 
+// Fuentes de corriente de burnout (Registro 1, bit 0)
+#define ADS1220_BCS_OFF         0x00
+#define ADS1220_BCS_ON          0x01    // 10 µA: AINP hacia AVDD, AINN hacia AVSS
+
 // Referencia de voltaje (Registro 2, bits 7:6)
 #define ADS1220_VREF_INTERNAL   0x00
 #define ADS1220_VREF_REFP0      0x40
@@ -129,6 +145,114 @@
 #define NTC_C_COEFF             1.540123584e-07f
 #define NTC_T0_KELVIN           298.15f // A 25°C
 
+// ===== HUELLA DE MEMORIA (configurable en compilación) =====
+// Definir con -D en las opciones de compilación (build_flags en PlatformIO):
+// un #define en el sketch no llega al .cpp de la librería.
+#ifndef ADS1220_MAX_AVG_SIZE
+#define ADS1220_MAX_AVG_SIZE    20      // Promedio móvil interno (8 bytes c/u); 0 = solo setFilterStorage()
+#endif
+
+#ifndef ADS1220_DEBUG_STATE
+#define ADS1220_DEBUG_STATE     1       // 0 = sin _lastVoltage/_lastTemperature/... (20 bytes)
+#endif
+
+#ifndef ADS1220_RESPONSE_COMPENSATION
+#define ADS1220_RESPONSE_COMPENSATION 1 // 0 = sin compensador de respuesta dinámica
+#endif
+
+// Funciones opcionales: con 0 su estado no ocupa memoria y su API queda sin
+// efecto (las lecturas siguen funcionando)
+#ifndef ADS1220_SENSOR_DIAGNOSTICS
+#define ADS1220_SENSOR_DIAGNOSTICS 1    // 0 = sin conversiones de burnout (setSensorDiagnostics)
+#endif
+
+#ifndef ADS1220_DECIMATION
+#define ADS1220_DECIMATION      1       // 0 = sin flujos diezmados (setDecimatedRate)
+#endif
+
+#ifndef ADS1220_STATISTICS
+#define ADS1220_STATISTICS      1       // 0 = sin estadísticas por conversión ni bloques periódicos
+#endif
+
+#ifndef ADS1220_EVENT_REPORTING
+#define ADS1220_EVENT_REPORTING 1       // 0 = sin informe por eventos ni cola de eventos
+#endif
+
+#ifndef ADS1220_ENERGY_ACCUMULATOR
+#define ADS1220_ENERGY_ACCUMULATOR 1    // 0 = sin acumulador de energía térmica
+#endif
+
+#ifndef ADS1220_PELTIER_CONTROL
+#define ADS1220_PELTIER_CONTROL 1       // 0 = sin control PID de Peltier
+#endif
+
+#ifndef ADS1220_CALIBRATION_CHANNELS
+#define ADS1220_CALIBRATION_CHANNELS 2  // 1 = ambos canales comparten Steinhart-Hart y gSKIN
+#endif
+
+// ===== MODELO DIRECTO CÓDIGO -> TEMPERATURA =====
+#ifndef ADS1220_MODEL_SEGMENTS
+#define ADS1220_MODEL_SEGMENTS  16      // Tramos cúbicos por canal (32 bytes c/u); 0 = sin modelo
+#endif
+
+// ===== LECTURA NO BLOQUEANTE =====
+#define ADS1220_READ_TIMEOUT_US     2000000UL   // Tiempo máximo de una lectura
+#define ADS1220_DEFAULT_SETTLE_US   10000UL     // Asentamiento tras cambiar MUX/IDAC
+
+// ===== DIAGNÓSTICO DE SENSORES =====
+#define ADS1220_BURNOUT_CURRENT     10e-6f      // Fuentes de burnout (BCS) [A]
+#define ADS1220_SATURATION_CODE     8220000L    // |código| ≥ 98% del fondo de escala = saturado
+#define ADS1220_NTC_MIN_TEMP        -55.0f      // Rango plausible de una NTC [°C]
+#define ADS1220_NTC_MAX_TEMP        150.0f
+#define ADS1220_DIAG_SHORT_OHMS     10.0f       // Resistencia de diagnóstico por defecto para "en corto" [Ω]
+
+// ===== REGISTRO DE MUESTRAS =====
+#ifndef ADS1220_SAMPLE_BUFFER_SIZE
+#define ADS1220_SAMPLE_BUFFER_SIZE  16      // Registros ADS1220_Sample en el buffer circular (mín. 1)
+#endif
+
+#if ADS1220_SAMPLE_BUFFER_SIZE < 1
+#error "ADS1220_SAMPLE_BUFFER_SIZE debe ser al menos 1"
+#endif
+
+#ifndef ADS1220_DECIMATED_BUFFER_SIZE
+#define ADS1220_DECIMATED_BUFFER_SIZE 4     // Muestras diezmadas pendientes por canal (mín. 1)
+#endif
+
+#if ADS1220_DECIMATED_BUFFER_SIZE < 1
+#error "ADS1220_DECIMATED_BUFFER_SIZE debe ser al menos 1"
+#endif
+
+#ifndef ADS1220_EVENT_BUFFER_SIZE
+#define ADS1220_EVENT_BUFFER_SIZE   8       // Eventos pendientes sin callback (ambos canales, mín. 1)
+#endif
+
+#if ADS1220_EVENT_BUFFER_SIZE < 1
+#error "ADS1220_EVENT_BUFFER_SIZE debe ser al menos 1"
+#endif
+#if ADS1220_CALIBRATION_CHANNELS < 1 || ADS1220_CALIBRATION_CHANNELS > 2
+#error "ADS1220_CALIBRATION_CHANNELS debe ser 1 o 2"
+#endif
+
+// ===== CONFIGURACIÓN PERSISTENTE =====
+#ifndef ADS1220_EEPROM_ADDRESS
+#define ADS1220_EEPROM_ADDRESS      0       // AVR: primer byte de la ranura 0 en EEPROM
+#endif
+#ifndef ADS1220_NVS_NAMESPACE
+#define ADS1220_NVS_NAMESPACE       "ads1220"   // ESP32: espacio de Preferences
+#endif
+
+// ===== CONTROL PID DE PELTIER =====
+#ifndef ADS1220_PWM_FREQUENCY
+#define ADS1220_PWM_FREQUENCY       20000   // PWM de la Peltier en ESP32 (LEDC) [Hz]
+#endif
+#ifndef ADS1220_PWM_RESOLUTION
+#define ADS1220_PWM_RESOLUTION      10      // Bits del PWM en ESP32 (en AVR: 8 bits de analogWrite)
+#endif
+#ifndef ADS1220_PWM_LEDC_CHANNEL
+#define ADS1220_PWM_LEDC_CHANNEL    0       // Canal LEDC (solo núcleos ESP32 2.x)
+#endif
+
 // ===== PARÁMETROS SENSORES DE FLUJO TÉRMICO POR DEFECTO =====
 // Basados en gSKIN-XI 27 9C (calibración específica del usuario)
 #define HFS_DEFAULT_SENSITIVITY     54.3f       // µV/(W/m²) @ To (valor calibrado)
@@ -147,6 +271,29 @@ enum ADS1220_SensorMode {
     MODE_HEAT_FLUX = 1      // Modo sensor de flujo térmico (IDAC OFF, lectura directa de voltaje)
 };
 
+enum ADS1220_ReadStatus {
+    READ_IDLE = 0,          // No hay lectura en curso
+    READ_PENDING = 1,       // Lectura en curso (asentamiento o conversión)
+    READ_READY = 2,         // Muestra completa entregada
+    READ_TIMEOUT = 3        // El ADC no entregó datos a tiempo; lectura cancelada
+};
+
+// Orden creciente de gravedad: getChannelHealth() devuelve la peor de las
+// dos fuentes (conversión de diagnóstico y comprobación de rango)
+enum ADS1220_ChannelHealth : uint8_t {
+    HEALTH_UNKNOWN = 0,         // Sin muestras ni diagnóstico todavía
+    HEALTH_OK = 1,
+    HEALTH_OUT_OF_RANGE = 2,    // Lectura saturada o fuera del rango del sensor
+    HEALTH_SHORT = 3,           // Sensor o cableado en corto
+    HEALTH_OPEN = 4             // Sensor desconectado o cable abierto
+};
+
+enum ADS1220_BusRequest {
+    BUS_NONE = 0,           // Sin lectura en curso
+    BUS_READ = 1,           // Lo siguiente es leer una conversión (RDATA)
+    BUS_WRITE = 2           // Lo siguiente es START/SYNC tras el asentamiento
+};
+
 // ===== ESTRUCTURAS =====
 struct HeatFluxCalibration {
     float So;           // Sensibilidad @ temperatura de calibración [µV/(W/m²)]
@@ -155,6 +302,48 @@ struct HeatFluxCalibration {
     float sensorArea;   // Área del sensor [m²]
 };
 
+// Suma compensada de Kahan: conserva la precisión al sumar millones de
+// incrementos pequeños en float (no compilar con -ffast-math)
+struct ADS1220_KahanSum {
+    float sum;
+    float compensation;
+    
+    void reset() { sum = 0.0f; compensation = 0.0f; }
+    void add(float value) {
+        float y = value - compensation;
+        float t = sum + y;
+        compensation = (t - sum) - y;
+        sum = t;
+    }
+};
+
+struct ADS1220_EnergySnapshot {
+    float energy_J;         // ∫Φ dt desde el último reset [J]
+    float fluence_Jm2;      // ∫φ dt desde el último reset [J/m²]
+    float elapsed_s;        // Tiempo integrado [s]
+    float meanPower_W;      // energy_J / elapsed_s [W]
+    float windowPower_W;    // Potencia media de la última ventana completa [W]
+    uint32_t samples;       // Conversiones integradas
+};
+
+// Posición de un consumidor en el buffer de muestras (ver attachSampleCursor())
+struct ADS1220_SampleCursor {
+    uint32_t position;      // Muestras escritas en el buffer antes de la siguiente a leer
+    uint32_t lost;          // Muestras sobrescritas antes de que este consumidor las leyera
+};
+
+// Recibe cada evento de setEventReporting() (value = valor filtrado)
+typedef void (*ADS1220_EventCallback)(const ADS1220_Sample &event, void* context);
+
+struct ADS1220_Statistics {
+    uint32_t count;         // Muestras desde el último reset
+    float mean;             // Media (°C o W/m²)
+    float stddev;           // Desviación estándar muestral (n - 1); ruido de la lectura
+    float min;
+    float max;
+    float duration_s;       // De la primera a la última muestra [s]
+};
+
 // ===== CLASE PRINCIPAL =====
 class ADS1220_NTC_Extended {
 public:
@@ -182,6 +371,37 @@ public:
      */
     bool begin(SPIClass *spiInstance = &SPI);
     
+    /**
+     * @brief Inicializa el ADS1220 sobre un transporte propio
+     * @param transport Backend SPI (DMA, CS rápido, ADS1220_MockTransport...)
+     * @return true si la inicialización fue exitosa
+     * 
+     * El transporte debe seguir vivo mientras se use el driver. El pin CS del
+     * constructor solo lo usa el transporte por defecto.
+     */
+    bool begin(ADS1220_Transport *transport);
+    
+    /**
+     * @brief Arranque rápido con la configuración guardada
+     * @param spiInstance Puntero a la instancia SPI
+     * @param slot Ranura de saveConfiguration()
+     * @return true si la inicialización fue exitosa
+     * 
+     * Carga la configuración y calibración de la ranura y lee los cuatro
+     * registros en una ráfaga (RREG). Si el ADS1220 conserva la configuración
+     * (reinicio del microcontrolador sin cortar su alimentación) no hay RESET
+     * ni escrituras; si no, RESET y una escritura en ráfaga verificada. Sin las
+     * esperas de begin(), la primera muestra llega tras unas pocas conversiones.
+     * Sin configuración válida guardada hace un begin() completo.
+     */
+    bool beginWarm(SPIClass *spiInstance = &SPI, uint16_t slot = 0);
+    bool beginWarm(ADS1220_Transport *transport, uint16_t slot = 0);
+    
+    /**
+     * @brief Indica si el último beginWarm() encontró el ADC ya configurado
+     */
+    bool wasWarmStart() { return _warmStart; }
+    
     // ===== CONFIGURACIÓN DE MODO DE OPERACIÓN =====
     /**
      * @brief Configura el modo de operación de un canal
@@ -202,6 +422,49 @@ public:
     void setIDACCurrent(float idacCurrent_uA);
     void setMeasuredIDACCurrent(float measuredCurrent_uA);
     void setMovingAverageSize(uint8_t size);
+    uint8_t getMovingAverageCapacity() { return _filterCapacity; }
+    
+    /**
+     * @brief Usa memoria del llamador para el promedio móvil
+     * @param storage Arena de 2 × size floats (nullptr = volver al buffer interno)
+     * @param size Muestras por canal
+     * 
+     * Permite compilar con ADS1220_MAX_AVG_SIZE = 0 y dar buffer solo a las
+     * instancias que filtran, o repartir un único arreglo entre varias. La
+     * arena debe seguir viva mientras se use el driver. Sin buffer, las
+     * funciones *Filtered() devuelven la lectura sin promediar.
+     */
+    void setFilterStorage(float* storage, uint8_t size);
+    
+    /**
+     * @brief Habilita el modo chopper (MUX invertido e IDAC intercambiadas) en un canal NTC
+     * @param channel Canal a configurar
+     * @param enable true para medir en pares de conversiones alternadas
+     * 
+     * Cada lectura toma dos conversiones: la normal y otra con la polaridad
+     * del MUX invertida y las fuentes IDAC1/IDAC2 intercambiadas. La
+     * corriente por la NTC no cambia de sentido. El driver combina el par
+     * como (A - B) / 2: se cancela el offset de entrada del ADC y se promedia
+     * el desajuste entre ambas fuentes IDAC. Las FEM termoeléctricas de
+     * cables y uniones NO se rechazan (tienen el mismo signo que la señal en
+     * ambas fases). Permite usar filtros más cortos.
+     */
+    void setChopMode(ADS1220_Channel channel, bool enable);
+    bool getChopMode(ADS1220_Channel channel);
+    
+    /**
+     * @brief Habilita la medición ratiométrica con resistencia de referencia
+     * @param channel Canal NTC a configurar
+     * @param referenceResistance Resistencia de referencia en Ω (0 = deshabilitado)
+     * 
+     * La corriente IDAC atraviesa el NTC y después la resistencia de referencia
+     * conectada entre REFP0 y REFN0, que se usa como VREF del ADC. Así:
+     *   R_ntc = (code / 2^23) × R_ref / Gain
+     * y el resultado no depende del valor real de la corriente IDAC, por lo que
+     * no hace falta setMeasuredIDACCurrent() ni recalibrarla por deriva.
+     */
+    void setReferenceResistor(ADS1220_Channel channel, float referenceResistance);
+    float getReferenceResistor(ADS1220_Channel channel);
     
     // ===== CONFIGURACIÓN SENSORES DE FLUJO TÉRMICO (NUEVO) =====
     
@@ -235,6 +498,74 @@ public:
      */
     HeatFluxCalibration getHeatFluxCalibration(ADS1220_Channel channel);
     
+    // ===== LECTURA NO BLOQUEANTE =====
+    
+    /**
+     * @brief Inicia una lectura sin bloquear
+     * @param channel Canal a leer
+     * @return false si ya hay una lectura en curso
+     * 
+     * Escribe la configuración del canal y regresa de inmediato. La lectura
+     * avanza con llamadas sucesivas a poll(); la librería no llama a delay()
+     * en este camino (los plazos se controlan con micros()).
+     */
+    bool startRead(ADS1220_Channel channel);
+    
+    /**
+     * @brief Avanza la lectura en curso
+     * @param sample Muestra completa cuando el estado es READ_READY
+     * @return READ_IDLE, READ_PENDING, READ_READY o READ_TIMEOUT
+     * 
+     * La muestra incluye el valor de ingeniería del canal: temperatura [°C]
+     * en modo NTC o flujo térmico [W/m²] en modo Heat Flux (corregido con la
+     * temperatura de setHeatFluxSensorTemperature()).
+     * 
+     * Ejemplo:
+     *   if (!sensor.isReadBusy()) sensor.startRead(CHANNEL_0);
+     *   ADS1220_Sample s;
+     *   if (sensor.poll(s) == READ_READY) { usar(s.value); }
+     */
+    ADS1220_ReadStatus poll(ADS1220_Sample &sample);
+    
+    /**
+     * @brief Indica si hay una lectura no bloqueante en curso
+     */
+    bool isReadBusy();
+    
+    /**
+     * @brief Cancela la lectura en curso (restaura el enrutamiento IDAC y los
+     *        registros que alteró un diagnóstico de sensor)
+     */
+    void cancelRead();
+    
+    /**
+     * @brief Próximo acceso al bus que necesita la lectura en curso
+     * @param wait_us Tiempo estimado hasta que poll() use el bus [µs] (0 = ya)
+     * @return BUS_NONE, BUS_READ o BUS_WRITE
+     * 
+     * Lo usa ADS1220_BusArbiter para atender primero las conversiones listas
+     * y no ceder el bus a otros dispositivos justo antes de un DRDY.
+     */
+    ADS1220_BusRequest busRequest(uint32_t &wait_us);
+    
+    /**
+     * @brief Tiempo de asentamiento tras cambiar MUX/IDAC antes de convertir
+     * @param settleTime_us Tiempo en µs (por defecto 10000)
+     * 
+     * Cubre la carga de los filtros RC de entrada al conmutar la corriente
+     * IDAC. Con DRDY conectado y sin filtros externos puede reducirse a 0.
+     */
+    void setSettlingTime(uint32_t settleTime_us);
+    
+    /**
+     * @brief Temperatura del sensor usada por las lecturas de flujo térmico
+     * @param channel Canal del sensor de flujo
+     * @param sensorTemp Temperatura del sensor [°C]
+     * 
+     * readHeatFlux() la actualiza con su argumento; poll() usa el último valor.
+     */
+    void setHeatFluxSensorTemperature(ADS1220_Channel channel, float sensorTemp);
+    
     // ===== FUNCIONES DE LECTURA NTC (modo existente) =====
     int32_t readRaw(ADS1220_Channel channel);
     float readVoltage(ADS1220_Channel channel);
@@ -242,6 +573,33 @@ public:
     float readTemperature(ADS1220_Channel channel);
     float readTemperatureFiltered(ADS1220_Channel channel);
     
+    // ===== MODELO DIRECTO CÓDIGO -> TEMPERATURA =====
+    
+    /**
+     * @brief Habilita el modelo directo T(code) para un canal NTC
+     * @param channel Canal NTC
+     * @param enable true para evaluar el modelo en readTemperature()
+     * @param minTemp Temperatura mínima del rango ajustado [°C]
+     * @param maxTemp Temperatura máxima del rango ajustado [°C]
+     * 
+     * El modelo es un polinomio cúbico por tramos (forma de Horner) indexado
+     * por la octava del código del ADC, ajustado contra la cadena completa
+     * code -> V -> R -> Steinhart-Hart. Se reajusta automáticamente cuando
+     * cambian la ganancia, la corriente IDAC, la resistencia de referencia o
+     * los coeficientes Steinhart-Hart. Fuera del rango ajustado se usa la
+     * cadena completa.
+     */
+    void setDirectTemperatureModel(ADS1220_Channel channel, bool enable,
+                                   float minTemp = -40.0f, float maxTemp = 125.0f);
+    
+    /**
+     * @brief Compara el modelo directo contra la cadena completa
+     * @param channel Canal NTC
+     * @param points Número de códigos evaluados (distribuidos por octava)
+     * @return Error absoluto máximo [°C] (-1 si el modelo no está habilitado)
+     */
+    float verifyDirectModel(ADS1220_Channel channel, uint16_t points = 256);
+    
     // ===== FUNCIONES DE LECTURA DE FLUJO TÉRMICO (NUEVO) =====
     
     /**
@@ -297,6 +655,9 @@ public:
      * @param channel Canal del sensor
      * @param sensorTemp Temperatura del sensor [°C]
      * @return Flujo térmico filtrado φ [W/m²]
+     * 
+     * Una lectura fallida (0) o saturada se devuelve sin filtrar y no entra
+     * en el filtro; getChannelHealth() indica la causa.
      */
     float readHeatFluxFiltered(ADS1220_Channel channel, float sensorTemp);
     
@@ -321,89 +682,781 @@ public:
      */
     float readThermalPowerFiltered(ADS1220_Channel channel, float sensorTemp);
     
+    // ===== ACUMULADOR DE ENERGÍA TÉRMICA =====
+    
+    /**
+     * @brief Integra flujo y potencia de un canal Heat Flux en cada conversión
+     * @param channel Canal del sensor de flujo
+     * @param enable true para integrar (reinicia el acumulador)
+     * 
+     * La integración (trapecios con los timestamps de las muestras y suma de
+     * Kahan) se hace dentro de la adquisición, así que cubre todas las
+     * conversiones del canal aunque la aplicación consulte una vez por segundo.
+     * Las muestras saturadas (sin ADS1220_SAMPLE_VALUE_VALID) cortan la
+     * integración: el hueco hasta la siguiente muestra válida no suma energía
+     * ni tiempo.
+     */
+    void enableEnergyAccumulator(ADS1220_Channel channel, bool enable = true);
+    
+    /**
+     * @brief Duración de la ventana de windowPower_W
+     * @param window_ms Ventana [ms] (por defecto 1000)
+     */
+    void setEnergyWindow(ADS1220_Channel channel, uint32_t window_ms);
+    
+    /**
+     * @brief Copia el estado del acumulador
+     * @param snapshot Energía, fluencia, tiempo y potencias medias
+     * @param reset true para reiniciar la integración en el mismo instante
+     * @return false si el acumulador del canal está deshabilitado
+     */
+    bool getEnergySnapshot(ADS1220_Channel channel, ADS1220_EnergySnapshot &snapshot, bool reset = false);
+    void resetEnergyAccumulator(ADS1220_Channel channel);
+    
+    // ===== ESTADÍSTICAS POR CONVERSIÓN =====
+    
+    /**
+     * @brief Acumula min/max/media/desviación del canal en cada conversión
+     * @param channel Canal
+     * @param enable true para acumular (reinicia las estadísticas)
+     * 
+     * Algoritmo de Welford dentro de la adquisición: un informe por segundo
+     * resume todas las conversiones del canal sin lecturas extra.
+     */
+    void enableStatistics(ADS1220_Channel channel, bool enable = true);
+    
+    /**
+     * @brief Copia las estadísticas y, opcionalmente, las reinicia
+     * @param stats Resultado (count = 0 si no hubo muestras)
+     * @param reset true para copiar y reiniciar sin perder ni repetir muestras
+     * @return false si las estadísticas del canal están deshabilitadas
+     * 
+     * La copia y el reinicio son atómicos respecto de la adquisición; en ESP32
+     * se puede llamar desde loop() con ADS1220_AsyncESP32 activo (igual que
+     * getEnergySnapshot()).
+     */
+    bool getStatistics(ADS1220_Channel channel, ADS1220_Statistics &stats, bool reset = false);
+    void resetStatistics(ADS1220_Channel channel);
+    
     // ===== FUNCIONES DE CONFIGURACIÓN DEL ADC =====
     void setGain(uint8_t gain);
     void setPGABypass(bool bypass);
     void setDataRate(uint8_t dataRate);
     void setConversionMode(uint8_t mode);
     
+    // ===== CALIBRACIÓN DE OFFSET =====
+    
+    /**
+     * @brief Mide el offset del ADC para la ganancia actual
+     * @param samples Número de conversiones a promediar (1-64)
+     * @return true si la medición fue exitosa
+     * 
+     * Usa el MUX interno con entradas en corto a (AVDD + AVSS)/2, por lo que
+     * no es necesario desconectar el sensor. El resultado se guarda en la
+     * tabla de offsets y se resta (en códigos) en cada lectura posterior.
+     * 
+     * Espera el asentamiento y cada conversión según el data rate (DRDY o
+     * periodo nominal con margen) y descarta la primera conversión tras el
+     * cambio de MUX: a 20 SPS con 8 muestras tarda ~0.5 s.
+     */
+    bool calibrateOffset(uint8_t samples = 8);
+    
+    /**
+     * @brief Mide el offset para las 8 ganancias del PGA
+     * @param samples Número de conversiones a promediar por ganancia
+     * @return true si todas las mediciones fueron exitosas
+     * 
+     * Restaura la ganancia que estaba configurada al terminar.
+     */
+    bool calibrateAllOffsets(uint8_t samples = 8);
+    
+    /**
+     * @brief Habilita o deshabilita la resta del offset calibrado
+     * @param enable true para corregir las lecturas (por defecto true)
+     */
+    void setOffsetCorrection(bool enable);
+    
+    /**
+     * @brief Configura la recalibración de offset en segundo plano
+     * @param conversions Cada cuántas lecturas se intercala una conversión
+     *                    de offset (0 = deshabilitado)
+     * 
+     * Ejemplo: con 100 se dedica ~1% de las conversiones a seguir la deriva
+     * del offset de la ganancia activa.
+     */
+    void setOffsetRefreshInterval(uint16_t conversions);
+    
+    /**
+     * @brief Obtiene el offset calibrado de una ganancia
+     * @param gain Ganancia (ADS1220_GAIN_1 ... ADS1220_GAIN_128)
+     * @return Offset en códigos del ADC (0 si no está calibrado)
+     */
+    int16_t getOffset(uint8_t gain);
+    
+    /**
+     * @brief Carga un offset conocido para una ganancia
+     * @param gain Ganancia (ADS1220_GAIN_1 ... ADS1220_GAIN_128)
+     * @param offset Offset en códigos del ADC
+     */
+    void setOffset(uint8_t gain, int16_t offset);
+    
+    // ===== CONFIGURACIÓN PERSISTENTE =====
+    
+    /**
+     * @brief Copia registros, modos y calibraciones a una ADS1220_Config
+     * 
+     * Incluye Steinhart-Hart, calibración gSKIN, corriente IDAC medida,
+     * resistencias de referencia, tabla de offsets, tamaño del promedio móvil
+     * y tiempo de asentamiento.
+     */
+    void exportConfiguration(ADS1220_Config &config);
+    
+    /**
+     * @brief Aplica una ADS1220_Config (el ADC la recibe en la siguiente lectura)
+     */
+    void importConfiguration(const ADS1220_Config &config);
+    
+    /**
+     * @brief Guarda la configuración (EEPROM en AVR, NVS en ESP32)
+     * @param slot Ranura (varias instancias o perfiles)
+     * @return false si la plataforma no tiene almacenamiento o la ranura no cabe
+     * 
+     * La imagen lleva versión y CRC-16 (ver ADS1220_Config.h). En AVR solo se
+     * escriben los bytes que cambian; en ESP32 no se escribe si es idéntica.
+     */
+    bool saveConfiguration(uint16_t slot = 0);
+    
+    /**
+     * @brief Carga y aplica la configuración guardada
+     * @return false si la ranura está vacía, es de otra versión o el CRC falla
+     */
+    bool loadConfiguration(uint16_t slot = 0);
+    
     // ===== FUNCIONES DE CONTROL =====
     void startConversion();
     bool dataReady();
     void powerDown();
     void reset();
+    uint8_t getDataReadyPin() { return _drdyPin; }
+    
+    // ===== VIGILANCIA DE REGISTROS =====
+    
+    /**
+     * @brief Verifica periódicamente los registros del ADC contra la configuración
+     * @param interval Conversiones entre verificaciones (0 = deshabilitado, 1 = todas)
+     * 
+     * Tras leer la conversión se leen los cuatro registros en una ráfaga RREG
+     * (unos 40 µs a 1 MHz). Si alguno difiere (RESET por ruido o caída de
+     * alimentación), la muestra lleva ADS1220_SAMPLE_CONFIG_FAULT y se
+     * reescriben solo los registros distintos.
+     */
+    void setRegisterWatchdog(uint16_t interval);
+    
+    /**
+     * @brief Verifica los registros ahora (sin lectura en curso)
+     * @return true si coincidían; false si hubo que restaurar alguno
+     */
+    bool checkRegisters();
+    
+    uint32_t getRegisterChecks() { return _registerChecks; }
+    uint32_t getRegisterFaults() { return _registerFaults; }
+    
+    // ===== DIAGNÓSTICO DE SENSORES =====
+    
+    /**
+     * @brief Intercala conversiones de diagnóstico con las fuentes de burnout
+     * @param interval Lecturas de cada canal entre diagnósticos (0 = deshabilitado)
+     * 
+     * Cada `interval` lecturas de un canal, startRead() antepone una conversión
+     * con BCS activo, IDAC apagado, referencia interna y PGA en bypass:
+     * V = 10 µA × R_sensor. Un sensor abierto satura y uno en corto da R
+     * por debajo del mínimo de setSensorResistanceRange(). Con
+     * interval = 50 a 20 SPS el coste es un 2% de conversiones y un fallo se
+     * detecta en menos de 5 s por canal.
+     */
+    void setSensorDiagnostics(uint16_t interval);
+    
+    /**
+     * @brief Resistencia aceptable del sensor en la conversión de diagnóstico
+     * @param minOhms Por debajo: HEALTH_SHORT (por defecto ADS1220_DIAG_SHORT_OHMS)
+     * @param maxOhms Por encima: HEALTH_OUT_OF_RANGE (0 = sin límite)
+     * 
+     * La conversión de diagnóstico (10 µA, ganancia 1, 2.048 V) satura por
+     * encima de ~200 kΩ: una NTC de 10 kΩ (B3950) por debajo de unos -30 °C
+     * o una de 100 kΩ por debajo de unos +10 °C. Saturada, el canal es
+     * HEALTH_OPEN solo si la conversión con IDAC que la sigue también satura
+     * o su resistencia supera maxOhms; si no, HEALTH_OUT_OF_RANGE.
+     */
+    void setSensorResistanceRange(ADS1220_Channel channel, float minOhms, float maxOhms = 0.0f);
+    
+    /**
+     * @brief Estado del canal: el peor entre el último diagnóstico y la última muestra
+     * 
+     * Cada muestra se comprueba además contra la saturación del ADC y, en
+     * modo NTC, contra ADS1220_NTC_MIN_TEMP .. ADS1220_NTC_MAX_TEMP. Las
+     * muestras de un canal con fallo llevan ADS1220_SAMPLE_SENSOR_FAULT y las
+     * saturadas pierden ADS1220_SAMPLE_VALUE_VALID.
+     */
+    ADS1220_ChannelHealth getChannelHealth(ADS1220_Channel channel);
+    
+    /**
+     * @brief Resistencia medida en el último diagnóstico [Ω] (0 si abierto o sin medir)
+     */
+    float getSensorResistance(ADS1220_Channel channel);
     
     // ===== FUNCIONES DE DEBUG =====
     void printRegisters(Stream* serial = &Serial);
     void printLastReading(Stream* serial = &Serial);
     void printHeatFluxInfo(ADS1220_Channel channel, Stream* serial = &Serial);
     bool testCommunication();
+    
+    /**
+     * @brief Imprime la memoria que ocupa la instancia, por bloque
+     * 
+     * Refleja la configuración de compilación (ADS1220_MAX_AVG_SIZE,
+     * ADS1220_MODEL_SEGMENTS, ADS1220_SAMPLE_BUFFER_SIZE, ...) y la arena
+     * externa asignada con setFilterStorage().
+     */
+    void printFootprint(Stream* serial = &Serial);
+    
+    // ===== REGISTRO Y STREAMING BINARIO DE MUESTRAS =====
+    
+    /**
+     * @brief Número de registros de muestra pendientes en el buffer
+     * 
+     * Cada conversión leída (readRaw(), readTemperature(), readHeatFlux(), ...)
+     * deja un registro ADS1220_Sample con timestamp, canal, código y, cuando se
+     * calcula, el valor de ingeniería. Si el buffer se llena se descarta el
+     * registro más antiguo y el siguiente lleva ADS1220_SAMPLE_OVERRUN.
+     */
+    uint8_t availableSamples();
+    
+    /**
+     * @brief Extrae el registro de muestra más antiguo
+     * @param sample Registro de salida
+     * @return false si no hay registros pendientes
+     */
+    bool readSample(ADS1220_Sample &sample);
+    
+    /**
+     * @brief Envía los registros pendientes en una trama binaria
+     * @param serial Puerto de salida
+     * @param includeValue true para incluir el valor de ingeniería (float32)
+     * @return Número de registros enviados (0 si no había pendientes)
+     * 
+     * Formato descrito en ADS1220_Protocol.h (cabecera de 12 bytes, 8 o 12
+     * bytes por registro y CRC-16). El decodificador de host está en
+     * extras/ads1220_decode. Si la trama lleva registros de flujo térmico,
+     * cada registro incluye además la temperatura del sensor con la que se
+     * calculó (ADS1220_FRAME_HAS_SENSOR_TEMP, +4 bytes) para poder
+     * reprocesarlo con ADS1220_Replay.
+     */
+    uint8_t writeBinaryFrame(Stream* serial = &Serial, bool includeValue = true);
+    
+    /**
+     * @brief Envía la configuración vigente en una trama ADS1220_FRAME_CONFIG
+     * @return Bytes enviados (ADS1220_CONFIG_FRAME_SIZE)
+     * 
+     * Al inicio de una grabación, antes de las tramas de muestras, para que
+     * ADS1220_Replay pueda reprocesarlas. Si la configuración cambia a mitad
+     * de la grabación, vaciar antes las muestras pendientes con
+     * writeBinaryFrame(): se convirtieron con la configuración anterior.
+     */
+    size_t writeConfigFrame(Stream* serial = &Serial);
+    
+    /**
+     * @brief Reprocesa un registro grabado como si acabara de convertirse
+     * @param recorded Registro decodificado (canal, código, timestamp, banderas)
+     * @param sample Registro resultante, igual que el de poll()
+     * @param sensorTemp Temperatura del sensor de flujo grabada con el registro
+     *                   (NAN = mantener la vigente)
+     * @return false si hay una lectura en curso o el canal no es válido
+     * 
+     * El código pasa por el mismo pipeline que una conversión real (valor de
+     * ingeniería, rango, buffer de muestras, diezmado, energía, estadísticas,
+     * filtro, control y eventos) con el timestamp grabado en lugar de
+     * micros(), así que el resultado es determinista. Las banderas CHOPPED,
+     * OFFSET_CORRECTED, CONFIG_FAULT y SENSOR_FAULT se conservan; el resto se
+     * recalcula. No toca el bus SPI ni la salida PWM (el PID sí se actualiza).
+     */
+    bool replaySample(const ADS1220_Sample &recorded, ADS1220_Sample &sample, float sensorTemp = NAN);
+    
+    // ===== SALIDA MULTI-TASA =====
+    
+    /**
+     * @brief Registra un consumidor adicional del buffer de muestras
+     * @param cursor Posición propia del consumidor
+     * @param fromOldest true para empezar por las muestras ya guardadas
+     * 
+     * Cada cursor lee el mismo flujo a tasa completa sin consumirlo para los
+     * demás (readSample() sin cursor, writeBinaryFrame() y otros cursores). Si
+     * un cursor se queda más de ADS1220_SAMPLE_BUFFER_SIZE muestras atrás,
+     * salta a la más antigua, suma las perdidas en cursor.lost y esa muestra
+     * lleva ADS1220_SAMPLE_OVERRUN.
+     */
+    void attachSampleCursor(ADS1220_SampleCursor &cursor, bool fromOldest = false);
+    uint8_t availableSamples(const ADS1220_SampleCursor &cursor);
+    bool readSample(ADS1220_SampleCursor &cursor, ADS1220_Sample &sample);
+    
+    /**
+     * @brief Flujo diezmado del canal a la tasa indicada
+     * @param rate_Hz Muestras por segundo de salida (0 = deshabilitado; mín. ~0.00025,
+     *                un bloque cada ~66 min)
+     * 
+     * Cada muestra válida del canal entra en un promedio por bloques de
+     * 1/rate_Hz (filtro sinc de primer orden: ceros en rate_Hz y sus
+     * múltiplos, que es donde cae el aliasing). value y raw son las medias
+     * del bloque y timestamp su centro. Se leen con readDecimated(); si no se
+     * leen, se conservan las ADS1220_DECIMATED_BUFFER_SIZE más recientes.
+     */
+    void setDecimatedRate(ADS1220_Channel channel, float rate_Hz);
+    uint8_t availableDecimated(ADS1220_Channel channel);
+    bool readDecimated(ADS1220_Channel channel, ADS1220_Sample &sample);
+    
+    /**
+     * @brief Publica las estadísticas del canal cada interval_ms
+     * @param interval_ms Periodo de los bloques (0 = deshabilitado, máx. 4000000)
+     * 
+     * Habilita las estadísticas del canal y, al cumplirse cada periodo,
+     * publica el bloque (como getStatistics(channel, stats, true)) para
+     * leerlo con readStatisticsBlock(). Un bloque no leído se reemplaza.
+     * Con 0 se detienen los bloques y se deshabilitan las estadísticas del
+     * canal; enableStatistics(channel, true) vuelve a acumularlas sin bloques.
+     */
+    void setStatisticsInterval(ADS1220_Channel channel, uint32_t interval_ms);
+    bool readStatisticsBlock(ADS1220_Channel channel, ADS1220_Statistics &stats);
+    
+    // ===== INFORME POR EVENTOS =====
+    
+    /**
+     * @brief Emite muestras del canal solo ante cambios significativos
+     * @param deadband Banda muerta absoluta (°C o W/m²)
+     * @param relativeDeadband Banda muerta relativa al último valor emitido (0.01 = 1%)
+     * @param maxSilence_ms Emite aunque no haya cambio tras este tiempo (0 = nunca;
+     *                      máx. 4000000 ms, ~66 min)
+     * 
+     * Se compara el valor filtrado (promedio móvil y compensador, igual que
+     * readTemperatureFiltered()) con el último emitido; se emite si difiere
+     * más que la mayor de las dos bandas, si se cumple maxSilence_ms o si el
+     * canal entra o sale de fallo (ADS1220_SAMPLE_SENSOR_FAULT). La primera
+     * muestra siempre se emite. Cada evento es el ADS1220_Sample de la
+     * conversión con value = valor filtrado.
+     */
+    void setEventReporting(ADS1220_Channel channel, float deadband, float relativeDeadband = 0.0f,
+                           uint32_t maxSilence_ms = 0);
+    void disableEventReporting(ADS1220_Channel channel);
+    
+    /**
+     * @brief Entrega los eventos a una función en lugar de a la cola
+     * @param callback Función llamada desde poll() (nullptr = usar la cola)
+     * @param context Puntero que se pasa al callback
+     * 
+     * Con ADS1220_AsyncESP32 el callback se ejecuta en la tarea de adquisición.
+     */
+    void setEventCallback(ADS1220_EventCallback callback, void* context = nullptr);
+    
+    /**
+     * @brief Eventos en cola (sin callback); se conservan los ADS1220_EVENT_BUFFER_SIZE más recientes
+     */
+    uint8_t availableEvents();
+    bool readEvent(ADS1220_Sample &event);
+    
+    /**
+     * @brief Muestras del canal descartadas por estar dentro de la banda muerta
+     */
+    uint32_t getSuppressedSamples(ADS1220_Channel channel);
+    
+    // ===== COMPENSACIÓN DE RESPUESTA DINÁMICA =====
+    
+    /**
+     * @brief Compensa la constante de tiempo térmica del sensor de un canal
+     * @param channel Canal
+     * @param tau1_s Constante de tiempo del sensor [s] (0 = deshabilitar)
+     * @param tau2_s Segunda constante [s] (0 = primer orden)
+     * @param maxGain Ganancia de alta frecuencia por etapa (amplificación del ruido)
+     * 
+     * Etapa de adelanto (τ·s + 1)/(τ/maxGain·s + 1) aplicada con cada muestra
+     * del canal después del promedio móvil: la respuesta efectiva pasa de τ a
+     * τ/maxGain. Mientras está activa, readTemperatureFiltered(),
+     * readHeatFluxFiltered() y el lazo PID usan el valor compensado.
+     */
+    void setResponseCompensation(ADS1220_Channel channel, float tau1_s, float tau2_s = 0.0f,
+                                 float maxGain = ADS1220_COMP_DEFAULT_MAX_GAIN);
+    
+    /**
+     * @brief Identifica τ del canal en el próximo escalón
+     * @param channel Canal
+     * @param stepThreshold Desviación que marca el escalón (°C o W/m², varias
+     *        veces el ruido de la lectura filtrada)
+     * 
+     * Leer el canal con la entrada estable, aplicar el escalón (p. ej. mover el
+     * sensor a otro baño) y seguir leyendo hasta que isIdentifyingResponse()
+     * sea false. Si terminó bien, queda una compensación de primer orden con el
+     * τ medido (incluye el retardo del promedio móvil).
+     */
+    void startResponseIdentification(ADS1220_Channel channel, float stepThreshold);
+    bool isIdentifyingResponse(ADS1220_Channel channel);
+    
+    /**
+     * @brief Constante de tiempo compensada [s] (0 = etapa sin usar)
+     */
+    float getResponseTimeConstant(ADS1220_Channel channel, uint8_t stage = 0);
+    
+    // ===== CONTROL PID DE PELTIER =====
+    
+    /**
+     * @brief Configura el lazo de control de la Peltier sobre un canal
+     * @param channel Canal cuyo valor (°C o W/m²) es la variable controlada
+     * @param pwmPin Pin PWM del driver de la Peltier
+     * @param dirPin Pin de dirección de un puente H (255 = solo un sentido)
+     * 
+     * El PID se actualiza dentro de poll() (y de las lecturas bloqueantes) con
+     * cada muestra nueva del canal, ya pasada por el promedio móvil, y escribe
+     * el PWM en ese mismo instante: el lazo va al ritmo del ADC y no del loop().
+     * Salida positiva = PWM con dirPin en HIGH; sin dirPin los límites quedan
+     * en 0..1 (usar ganancias negativas para enfriar). El lazo queda
+     * deshabilitado hasta enablePeltierControl(true).
+     */
+    void beginPeltierControl(ADS1220_Channel channel, uint8_t pwmPin, uint8_t dirPin = 255);
+    
+    void setPIDGains(float kp, float ki, float kd);
+    void setPIDSetpoint(float setpoint);
+    
+    /**
+     * @brief Límites de la salida como fracción del PWM (-1..1 con dirPin, 0..1 sin él)
+     */
+    void setPIDOutputLimits(float minOutput, float maxOutput);
+    
+    /**
+     * @brief Habilita o detiene el lazo (al detenerlo el PWM queda en 0)
+     */
+    void enablePeltierControl(bool enable);
+    bool isPeltierControlEnabled();
+    
+    /**
+     * @brief Última salida del PID (fracción con signo del PWM)
+     */
+    float getPIDOutput();
+    
+    /**
+     * @brief Latencia muestra -> actuación de la última actualización [µs]
+     * 
+     * Desde el primer poll() que vio la conversión lista (timestamp de la
+     * muestra, antes de RDATA) hasta que el nuevo ciclo de trabajo quedó
+     * escrito en el PWM: incluye la lectura SPI, el cálculo y el PID. Con
+     * DRDY el retraso entre el flanco y ese poll() depende de cada cuánto
+     * se llame a poll().
+     */
+    uint32_t getControlLatency_us();
+    uint32_t getMaxControlLatency_us();
+    uint32_t getControlUpdates();
+    void resetControlStatistics();
 
 private:
     // ===== VARIABLES PRIVADAS =====
-    SPIClass *_spi;
-    uint8_t _csPin;
+    ADS1220_SPITransport _defaultTransport;  // Backend de begin(SPIClass*)
+    ADS1220_Transport *_transport;           // nullptr hasta begin()
     uint8_t _drdyPin;
+    bool _warmStart;                         // El último beginWarm() no reescribió el ADC
     
     // Registros de configuración (shadow copy)
     uint8_t _reg0, _reg1, _reg2, _reg3;
     
     // Modo de operación por canal
     ADS1220_SensorMode _channelMode[2];  // [0]=Canal 0, [1]=Canal 1
+    bool _chopEnabled[2];                // Modo chopper por canal
     
-    // Parámetros NTC (Steinhart-Hart) por canal
-    float _ntc_A[2], _ntc_B[2], _ntc_C[2];
+    // Parámetros NTC (Steinhart-Hart) por canal (o compartidos, ver _cal())
+    float _ntc_A[ADS1220_CALIBRATION_CHANNELS];
+    float _ntc_B[ADS1220_CALIBRATION_CHANNELS];
+    float _ntc_C[ADS1220_CALIBRATION_CHANNELS];
     
     // Parámetros de calibración de flujo térmico por canal
-    HeatFluxCalibration _heatFluxCal[2];
+    HeatFluxCalibration _heatFluxCal[ADS1220_CALIBRATION_CHANNELS];
+    float _hfSensorTemp[2];              // Temperatura del sensor para poll() [°C]
     
     // Corriente IDAC real (en amperes)
     float _idacCurrent;
     
+    // Medición ratiométrica: resistencia de referencia en REFP0/REFN0 por canal
+    float _refResistance[2];             // 0 = referencia interna
+    float _ratioScale[2];                // R_ref / (Gain × MAX_CODE) [Ω/código]
+    
     // Ganancia actual del PGA (valor numérico: 1, 2, 4, 8, 16, 32, 64, 128)
     uint8_t _currentGain;
     
+    // Tabla de offsets por ganancia (índice = bits de ganancia del Registro 0)
+    int16_t _offsetTable[8];
+    uint8_t _offsetValid;                // Bit n = offset de la ganancia n calibrado
+    bool _offsetCorrection;
+    uint16_t _offsetRefreshInterval;     // 0 = sin recalibración en segundo plano
+    uint16_t _conversionsSinceRefresh;
+    
+    // Modelo directo T(code): tramos cúbicos T = c0 + w(c1 + w(c2 + w·c3))
+    struct ModelSegment {
+        float c0, c1, c2, c3;
+    };
+#if ADS1220_MODEL_SEGMENTS > 0
+    ModelSegment _model[2][ADS1220_MODEL_SEGMENTS];
+#endif
+    bool _modelEnabled[2];
+    uint8_t _modelDirty;                 // Bit n = canal n requiere reajuste
+    int8_t _modelFirstOctave[2];         // Octava (log2 del código) del primer tramo
+    uint8_t _modelSubBits[2];            // log2(tramos por octava)
+    uint8_t _modelSegments[2];           // Tramos válidos
+    float _modelMinTemp[2], _modelMaxTemp[2];
+    
     // Buffer para moving average (usado tanto para NTC como para Heat Flux)
-    static const uint8_t MAX_AVG_SIZE = 20;
-    float _tempBuffer[2][MAX_AVG_SIZE];  // Buffer genérico para ambos modos
+#if ADS1220_MAX_AVG_SIZE > 0
+    float _tempBuffer[2][ADS1220_MAX_AVG_SIZE];  // Buffer interno para ambos modos
+#endif
+    float* _filterBuffer;                // Canal ch en [ch × _filterCapacity]
+    uint8_t _filterCapacity;             // Muestras por canal disponibles
+    bool _filterExternal;                // _filterBuffer apunta a una arena del llamador
     uint8_t _avgSize;
     uint8_t _bufferIndex[2];
     bool _bufferFull[2];
     
-    // Variables de debug
+    // Variables de debug (_lastRawReading y _lastChannel se usan en los cálculos)
     int32_t _lastRawReading;
+    ADS1220_Channel _lastChannel;
+#if ADS1220_DEBUG_STATE
     float _lastVoltage;
     float _lastResistance;       // Para modo NTC
     float _lastTemperature;      // Para modo NTC
     float _lastHeatFlux;         // Para modo Heat Flux
     float _lastThermalPower;     // Para modo Heat Flux
-    ADS1220_Channel _lastChannel;
+#endif
+    
+    // Máquina de estados de lectura no bloqueante
+    enum ReadState : uint8_t {
+        STATE_IDLE,
+        STATE_SETTLING,                  // Registros escritos, esperando asentamiento
+        STATE_CONVERTING                 // START enviado, esperando DRDY / tiempo de conversión
+    };
+    enum ReadPhase : uint8_t {
+        PHASE_OFFSET,                    // Conversión de offset intercalada
+        PHASE_DIAG,                      // Conversión con fuentes de burnout intercalada
+        PHASE_MAIN,                      // Conversión del canal (fase A en chopper)
+        PHASE_CHOP_B                     // Fase invertida del modo chopper
+    };
+    ReadState _readState;
+    ReadPhase _readPhase;
+    ADS1220_Channel _readChannel;
+    uint32_t _readStart_us;
+    uint32_t _phaseStart_us;
+    uint32_t _settleTime_us;
+    int32_t _chopCode;                   // Código de la fase A del chopper
+    
+    // Vigilancia de registros
+    uint16_t _watchdogInterval;          // 0 = deshabilitada
+    uint16_t _watchdogCount;
+    uint32_t _registerChecks;
+    uint32_t _registerFaults;
+    
+    // Diagnóstico de sensores (fuentes de burnout + comprobación de rango)
+    ADS1220_ChannelHealth _rangeHealth[2];   // Última muestra del canal
+#if ADS1220_SENSOR_DIAGNOSTICS
+    uint16_t _diagInterval;              // 0 = sin conversiones de diagnóstico
+    uint16_t _diagCount[2];
+    ADS1220_ChannelHealth _diagHealth[2];    // Última conversión de diagnóstico
+    float _diagResistance[2];            // [Ω]
+    float _diagMinOhms[2];
+    float _diagMaxOhms[2];               // 0 = sin límite
+    float _diagSignal[2];                // Voltaje de la última muestra de flujo [V]
+    uint8_t _diagSaturated;              // Bit n = diagnóstico saturado, se decide con la muestra
+#endif
+    
+    // Buffer circular de registros de muestra
+    ADS1220_Sample _samples[ADS1220_SAMPLE_BUFFER_SIZE];
+    float _sampleSensorTemp[ADS1220_SAMPLE_BUFFER_SIZE];  // _hfSensorTemp de cada registro (grabación)
+    uint8_t _sampleHead;                 // Próxima posición de escritura
+    uint8_t _sampleCount;
+    uint16_t _frameSequence;
+    uint32_t _sampleTotal;               // Muestras escritas (posición de los cursores)
+    
+    // Flujo diezmado por canal: promedio por bloques de period_us
+    struct Decimator {
+        uint32_t period_us;              // 0 = deshabilitado
+        uint32_t firstTimestamp;         // Primera y última muestra del bloque
+        uint32_t lastTimestamp;
+        int64_t rawSum;
+        float mean;                      // Media incremental (sin sumar valores grandes)
+        uint32_t count;                  // Conversiones del bloque (puede superar 65535)
+        uint8_t flags;                   // OR de las banderas del bloque
+        uint8_t head;
+        uint8_t pending;
+        ADS1220_Sample out[ADS1220_DECIMATED_BUFFER_SIZE];
+    };
+#if ADS1220_DECIMATION
+    Decimator _decimator[2];
+#endif
+    
+    // Bloques periódicos de estadísticas (un bloque pendiente por canal)
+#if ADS1220_STATISTICS
+    uint32_t _statsInterval_us[2];       // 0 = sin publicación periódica
+    ADS1220_Statistics _statsBlock[2];
+    bool _statsBlockReady[2];
+#endif
+    
+    // Informe por eventos: banda muerta sobre la salida de la etapa por muestra
+    struct EventReporter {
+        float deadband;
+        float relative;                  // Fracción del último valor emitido
+        uint32_t maxSilence_us;          // 0 = sin emisión periódica
+        float lastValue;                 // Último valor emitido
+        uint32_t lastTimestamp;
+        uint32_t suppressed;
+        bool enabled;
+        bool primed;                     // Ya se emitió la primera muestra
+        bool lastFault;                  // ADS1220_SAMPLE_SENSOR_FAULT del último evento
+    };
+#if ADS1220_EVENT_REPORTING
+    EventReporter _events[2];
+    ADS1220_EventCallback _eventCallback;
+    void* _eventContext;
+    ADS1220_Sample _eventQueue[ADS1220_EVENT_BUFFER_SIZE];
+    uint8_t _eventHead;
+    uint8_t _eventCount;
+#endif
+    
+    // Acumulador de energía térmica por canal (se actualiza desde _finishRead())
+    struct EnergyAccumulator {
+        ADS1220_KahanSum energy;         // [J]
+        ADS1220_KahanSum fluence;        // [J/m²]
+        uint64_t elapsed_us;
+        uint32_t samples;
+        uint32_t prevTimestamp;
+        float prevFlux;                  // [W/m²]
+        float windowEnergy;              // [J]
+        uint32_t windowElapsed_us;
+        uint32_t window_us;
+        float windowPower;               // [W]
+        bool enabled;
+        bool primed;                     // Hay muestra anterior para el trapecio
+    };
+#if ADS1220_ENERGY_ACCUMULATOR
+    EnergyAccumulator _energy[2];
+#endif
+    
+    // Estadísticas de Welford por canal (se actualizan desde _finishRead())
+    struct RunningStatistics {
+        uint32_t count;
+        float mean;
+        float m2;                        // Σ(x - media)²
+        float min;
+        float max;
+        uint32_t firstTimestamp;
+        uint32_t lastTimestamp;
+        bool enabled;
+    };
+#if ADS1220_STATISTICS
+    RunningStatistics _stats[2];
+#endif
+    
+    // Etapa por muestra (promedio móvil + compensador) para canales que la usan
+    float _stageValue[2];                // Última salida de la etapa
+    uint32_t _stageLast_us[2];           // Timestamp de la muestra anterior del canal
+#if ADS1220_RESPONSE_COMPENSATION
+    ADS1220_Compensator _compensator[2];
+#endif
+    
+    // Control PID de la Peltier (se actualiza desde _finishRead())
+#if ADS1220_PELTIER_CONTROL
+    ADS1220_PID _pid;
+    bool _controlEnabled;
+    ADS1220_Channel _controlChannel;
+    uint8_t _pwmPin;                     // 255 = control sin configurar
+    uint8_t _dirPin;                     // 255 = sin puente H
+    uint16_t _pwmMax;                    // Cuenta del PWM para |salida| = 1
+    uint32_t _controlLatency_us;
+    uint32_t _controlMaxLatency_us;
+    uint32_t _controlUpdates;
+#endif
+    bool _replaying;                     // replaySample() en curso: sin PWM
     
     // ===== FUNCIONES PRIVADAS SPI =====
     void sendCommand(uint8_t cmd);
     uint8_t readRegister(uint8_t reg);
+    void readRegisters(uint8_t firstReg, uint8_t count, uint8_t* values);
     void writeRegister(uint8_t reg, uint8_t value);
+    void writeRegisters(uint8_t firstReg, uint8_t count);
     int32_t readConversionData();
     
     // ===== FUNCIONES PRIVADAS DE CONFIGURACIÓN =====
     void configureChannel(ADS1220_Channel channel);
     void configureIDAC(ADS1220_Channel channel);
+    
+    // ===== FUNCIONES PRIVADAS DE LECTURA NO BLOQUEANTE =====
+    void _beginPhase(ReadPhase phase);
+    bool _conversionReady(uint32_t now);
+    bool _convertBlocking(int32_t &code);
+    uint32_t _conversionTime_us();
+    void _finishRead(int32_t rawValue, uint8_t flags, uint32_t timestamp, ADS1220_Sample &sample);
+    float _computeValue(uint8_t ch, int32_t rawValue, uint8_t &flags);
+    bool _readBlocking(ADS1220_Channel channel, ADS1220_Sample &sample);
+    bool _readHeatFluxVoltage(ADS1220_Channel channel, float &voltage_uV);
+    bool _readHeatFlux(ADS1220_Channel channel, float sensorTemp, float &heatFlux);
     uint8_t _getCurrentRegisterSetting(float desiredCurrent_uA);
+    uint8_t _chopReg3() { return ((_reg3 >> 3) & 0x1C) | ((_reg3 << 3) & 0xE0) | (_reg3 & 0x03); }
+    bool _watchdogDue();
+    bool _verifyRegisters(uint8_t expectedReg3);
+    void _evaluateDiagnostic(uint8_t ch, int32_t code);
+    ADS1220_ChannelHealth _saturatedDiagnostic(uint8_t ch, int32_t rawValue);
+    ADS1220_ChannelHealth _checkRange(uint8_t ch, int32_t rawValue, float value);
+    
+    // ===== FUNCIONES PRIVADAS DE CALIBRACIÓN =====
+    bool _measureShortedInput(uint8_t samples, int32_t &offset);
+    int32_t _applyOffset(int32_t rawValue);
+    void _updateBackgroundOffset(int32_t offset);
+    uint8_t _offsetFlag();
+    
+    // ===== FUNCIONES PRIVADAS DE REGISTRO DE MUESTRAS =====
+    void _pushSample(const ADS1220_Sample &sample);
+    void _setLastSampleValue(float value, uint8_t flags);
+    void _decimate(uint8_t ch, const ADS1220_Sample &sample);
+    void _reportEvent(uint8_t ch, const ADS1220_Sample &sample);
+    
+    // ===== FUNCIONES PRIVADAS DEL ACUMULADOR DE ENERGÍA Y ESTADÍSTICAS =====
+    void _accumulateEnergy(uint8_t ch, const ADS1220_Sample &sample);
+    void _breakEnergy(uint8_t ch);
+    void _resetEnergy(EnergyAccumulator &acc);
+    void _updateStatistics(uint8_t ch, const ADS1220_Sample &sample);
+    void _resetStatistics(RunningStatistics &run);
+    void _deriveStatistics(const RunningStatistics &run, ADS1220_Statistics &stats);
+    
+    // ===== FUNCIONES PRIVADAS DE ETAPA POR MUESTRA Y CONTROL PID =====
+    bool _stageActive(ADS1220_Channel channel);
+    float _filterStage(ADS1220_Channel channel, float value, uint32_t dt_us);
+#if ADS1220_PELTIER_CONTROL
+    bool _controlsChannel(ADS1220_Channel channel) { return _controlEnabled && channel == _controlChannel; }
+#else
+    bool _controlsChannel(ADS1220_Channel) { return false; }
+#endif
+    void _controlUpdate(const ADS1220_Sample &sample, uint32_t dt_us);
+    void _writePWM(int32_t duty);
     
     // ===== FUNCIONES PRIVADAS DE CÁLCULO NTC =====
     float rawToVoltage(int32_t rawValue);
     float voltageToResistance(float voltage);
+    float rawToResistance(uint8_t ch, int32_t rawValue);
+    void _updateRatiometricScale();
     float resistanceToTemperature(float resistance);
+    float _steinhartHart(uint8_t ch, float resistance);
+    float _chainTemperature(uint8_t ch, int32_t rawValue);
+    
+    // ===== FUNCIONES PRIVADAS DEL MODELO DIRECTO =====
+    void _fitDirectModel(uint8_t ch);
+    bool _evaluateDirectModel(uint8_t ch, int32_t rawValue, float &temperature);
+    int32_t _temperatureToCode(uint8_t ch, float temperature);
     
     // ===== FUNCIONES PRIVADAS DE CÁLCULO HEAT FLUX =====
     float voltageToHeatFlux(float voltage_uV, float sensitivity);
     float heatFluxToThermalPower(float heatFlux, float sensorArea);
     
     // ===== FUNCIONES AUXILIARES =====
+    static uint8_t _cal(uint8_t ch) { return (ADS1220_CALIBRATION_CHANNELS > 1) ? ch : 0; }
     float updateMovingAverage(ADS1220_Channel channel, float newValue);
-    void csLow();
-    void csHigh();
-    bool waitForData(uint16_t timeout_ms = 1000);
     void _init_pwm_arduino();
     void _init_pwm_esp32();
 };
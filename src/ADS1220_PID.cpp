@@ -0,0 +1,220 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Controlador PID discreto
+ ******************************************************************************/
+
+#include "ADS1220_PID.h"
+
+#if ADS1220_PID_FIXED_POINT
+
+// =============================================================================
+// AUXILIARES Q16.16
+// =============================================================================
+
+static int32_t toQ16(float value) {
+    return (int32_t)(value * 65536.0f + (value >= 0.0f ? 0.5f : -0.5f));
+}
+
+static float fromQ16(int32_t value) {
+    return (float)value * (1.0f / 65536.0f);
+}
+
+static int32_t mulQ16(int32_t a, int32_t b) {
+    return (int32_t)(((int64_t)a * b) >> 16);
+}
+
+// =============================================================================
+// PID EN PUNTO FIJO
+// =============================================================================
+
+ADS1220_PID::ADS1220_PID() {
+    _kp = 0;
+    _ki = 0;
+    _kd = 0;
+    _setpoint = 0;
+    _minOutput = toQ16(-1.0f);
+    _maxOutput = toQ16(1.0f);
+    _invDtRef_us = 0;
+    _invDt = 0;
+    reset();
+}
+
+void ADS1220_PID::setGains(float kp, float ki, float kd) {
+    _kp = toQ16(kp);
+    _ki = toQ16(ki);
+    _kd = toQ16(kd);
+}
+
+void ADS1220_PID::setOutputLimits(float minOutput, float maxOutput) {
+    _minOutput = toQ16(minOutput);
+    _maxOutput = toQ16(maxOutput);
+}
+
+void ADS1220_PID::setSetpoint(float setpoint) {
+    _setpoint = toQ16(setpoint);
+}
+
+float ADS1220_PID::getSetpoint() const {
+    return fromQ16(_setpoint);
+}
+
+void ADS1220_PID::reset() {
+    _integral = 0;
+    _prevMeasurement = 0;
+    _output = 0;
+    _first = true;
+    _saturated = false;
+}
+
+void ADS1220_PID::update(float measurement, uint32_t dt_us) {
+    int32_t meas = toQ16(measurement);
+    int32_t error = _setpoint - meas;
+    int32_t p = mulQ16(_kp, error);
+    int32_t d = 0;
+    int64_t step = 0;
+
+    if (!_first && dt_us > 0) {
+        if (dt_us < 32) dt_us = 32;  // 1/dt debe caber en Q16.16
+
+        // 1/dt solo se recalcula (división de 64 bits) si dt cambió más de 1/64
+        uint32_t diff = (dt_us > _invDtRef_us) ? dt_us - _invDtRef_us : _invDtRef_us - dt_us;
+        if (_invDtRef_us == 0 || diff > (_invDtRef_us >> 6)) {
+            _invDt = (int32_t)((1000000ULL << 16) / dt_us);
+            _invDtRef_us = dt_us;
+        }
+
+        // Derivada sobre la medición: -Kd·dM/dt
+        int32_t rate = mulQ16(meas - _prevMeasurement, _invDt);
+        d = -mulQ16(_kd, rate);
+
+        // dt [s] en Q16.16 = dt_us · 65536 / 10^6; paso del integrador en Q32.32
+        int32_t dt = (int32_t)(((uint64_t)dt_us * 4295UL) >> 16);
+        step = (((int64_t)_ki * error) >> 8) * dt >> 8;
+    }
+
+    // Anti-windup: no integrar si la salida ya satura en la dirección del error
+    int32_t unsaturated = p + (int32_t)(_integral >> 16) + d;
+    bool blockUp = (unsaturated >= _maxOutput) && (error > 0);
+    bool blockDown = (unsaturated <= _minOutput) && (error < 0);
+    if (!blockUp && !blockDown) {
+        _integral += step;
+    }
+
+    int64_t integralMax = (int64_t)_maxOutput << 16;
+    int64_t integralMin = (int64_t)_minOutput << 16;
+    if (_integral > integralMax) _integral = integralMax;
+    if (_integral < integralMin) _integral = integralMin;
+
+    int32_t output = p + (int32_t)(_integral >> 16) + d;
+    _saturated = true;
+    if (output > _maxOutput) {
+        output = _maxOutput;
+    } else if (output < _minOutput) {
+        output = _minOutput;
+    } else {
+        _saturated = false;
+    }
+
+    _output = output;
+    _prevMeasurement = meas;
+    _first = false;
+}
+
+float ADS1220_PID::getOutput() const {
+    return fromQ16(_output);
+}
+
+int32_t ADS1220_PID::getOutputScaled(uint16_t fullScale) const {
+    return (int32_t)(((int64_t)_output * fullScale) >> 16);
+}
+
+#else // ADS1220_PID_FIXED_POINT
+
+// =============================================================================
+// PID EN PUNTO FLOTANTE
+// =============================================================================
+
+ADS1220_PID::ADS1220_PID() {
+    _kp = 0.0f;
+    _ki = 0.0f;
+    _kd = 0.0f;
+    _setpoint = 0.0f;
+    _minOutput = -1.0f;
+    _maxOutput = 1.0f;
+    reset();
+}
+
+void ADS1220_PID::setGains(float kp, float ki, float kd) {
+    _kp = kp;
+    _ki = ki;
+    _kd = kd;
+}
+
+void ADS1220_PID::setOutputLimits(float minOutput, float maxOutput) {
+    _minOutput = minOutput;
+    _maxOutput = maxOutput;
+}
+
+void ADS1220_PID::setSetpoint(float setpoint) {
+    _setpoint = setpoint;
+}
+
+float ADS1220_PID::getSetpoint() const {
+    return _setpoint;
+}
+
+void ADS1220_PID::reset() {
+    _integral = 0.0f;
+    _prevMeasurement = 0.0f;
+    _output = 0.0f;
+    _first = true;
+    _saturated = false;
+}
+
+void ADS1220_PID::update(float measurement, uint32_t dt_us) {
+    float error = _setpoint - measurement;
+    float p = _kp * error;
+    float d = 0.0f;
+    float step = 0.0f;
+
+    if (!_first && dt_us > 0) {
+        float dt = (float)dt_us * 1e-6f;
+        // Derivada sobre la medición: -Kd·dM/dt
+        d = -_kd * (measurement - _prevMeasurement) / dt;
+        step = _ki * error * dt;
+    }
+
+    // Anti-windup: no integrar si la salida ya satura en la dirección del error
+    float unsaturated = p + _integral + d;
+    bool blockUp = (unsaturated >= _maxOutput) && (error > 0.0f);
+    bool blockDown = (unsaturated <= _minOutput) && (error < 0.0f);
+    if (!blockUp && !blockDown) {
+        _integral += step;
+    }
+    if (_integral > _maxOutput) _integral = _maxOutput;
+    if (_integral < _minOutput) _integral = _minOutput;
+
+    float output = p + _integral + d;
+    _saturated = true;
+    if (output > _maxOutput) {
+        output = _maxOutput;
+    } else if (output < _minOutput) {
+        output = _minOutput;
+    } else {
+        _saturated = false;
+    }
+
+    _output = output;
+    _prevMeasurement = measurement;
+    _first = false;
+}
+
+float ADS1220_PID::getOutput() const {
+    return _output;
+}
+
+int32_t ADS1220_PID::getOutputScaled(uint16_t fullScale) const {
+    float scaled = _output * (float)fullScale;
+    return (int32_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+}
+
+#endif // ADS1220_PID_FIXED_POINT
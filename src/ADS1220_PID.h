@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Controlador PID discreto
+ *
+ * PID con paso de tiempo variable (dt de cada muestra), derivada sobre la
+ * medición (sin golpe al cambiar el setpoint) y anti-windup por integración
+ * condicional más límite del integrador. La salida queda en las unidades de
+ * setOutputLimits() (por defecto -1..1 = ciclo de trabajo con signo).
+ *
+ * En AVR (o con ADS1220_PID_FIXED_POINT = 1) toda la actualización es en
+ * punto fijo Q16.16 con integrador Q32: una sola conversión float -> Q16 de la
+ * medición y sin divisiones en el camino normal.
+ *
+ * Este archivo no depende de Arduino.
+ ******************************************************************************/
+
+#ifndef ADS1220_PID_H
+#define ADS1220_PID_H
+
+#include <stdint.h>
+
+#ifndef ADS1220_PID_FIXED_POINT
+#if defined(__AVR__)
+#define ADS1220_PID_FIXED_POINT 1
+#else
+#define ADS1220_PID_FIXED_POINT 0
+#endif
+#endif
+
+class ADS1220_PID {
+public:
+    ADS1220_PID();
+
+    /**
+     * @brief Ganancias en unidades de salida por unidad de medición
+     * @param kp Proporcional [1/°C]
+     * @param ki Integral [1/(°C·s)]
+     * @param kd Derivativa [s/°C]
+     */
+    void setGains(float kp, float ki, float kd);
+    void setOutputLimits(float minOutput, float maxOutput);
+    void setSetpoint(float setpoint);
+    float getSetpoint() const;
+
+    /**
+     * @brief Borra integrador y derivada (la siguiente muestra reinicia)
+     */
+    void reset();
+
+    /**
+     * @brief Actualiza el controlador con una muestra nueva
+     * @param measurement Medición (p. ej. temperatura filtrada [°C])
+     * @param dt_us Tiempo desde la muestra anterior [µs] (ignorado en la primera)
+     */
+    void update(float measurement, uint32_t dt_us);
+
+    float getOutput() const;
+
+    /**
+     * @brief Salida escalada a un entero con signo (para PWM)
+     * @param fullScale Cuenta que corresponde a |salida| = 1.0
+     */
+    int32_t getOutputScaled(uint16_t fullScale) const;
+
+    bool isSaturated() const { return _saturated; }
+
+private:
+#if ADS1220_PID_FIXED_POINT
+    int32_t _kp, _ki, _kd;               // Q16.16
+    int32_t _setpoint;                   // Q16.16
+    int32_t _minOutput, _maxOutput;      // Q16.16
+    int64_t _integral;                   // Q32.32
+    int32_t _prevMeasurement;            // Q16.16
+    int32_t _output;                     // Q16.16
+    uint32_t _invDtRef_us;               // dt para el que se calculó _invDt
+    int32_t _invDt;                      // 1/dt [1/s] en Q16.16
+#else
+    float _kp, _ki, _kd;
+    float _setpoint;
+    float _minOutput, _maxOutput;
+    float _integral;
+    float _prevMeasurement;
+    float _output;
+#endif
+    bool _first;
+    bool _saturated;
+};
+
+#endif // ADS1220_PID_H
@@ -0,0 +1,330 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Protocolo binario de streaming
+ *
+ * Codificador y decodificador de tramas. Sin dependencias de Arduino para que
+ * el mismo código se use en el microcontrolador y en las herramientas de host.
+ ******************************************************************************/
+
+#include "ADS1220_Protocol.h"
+#include <string.h>
+
+// =============================================================================
+// AUXILIARES LITTLE-ENDIAN
+// =============================================================================
+
+static void putU16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)(value & 0xFF);
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void putU24(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)(value & 0xFF);
+    out[1] = (uint8_t)((value >> 8) & 0xFF);
+    out[2] = (uint8_t)((value >> 16) & 0xFF);
+}
+
+static void putU32(uint8_t* out, uint32_t value) {
+    putU16(out, (uint16_t)(value & 0xFFFF));
+    putU16(out + 2, (uint16_t)(value >> 16));
+}
+
+static uint16_t getU16(const uint8_t* in) {
+    return (uint16_t)in[0] | ((uint16_t)in[1] << 8);
+}
+
+static uint32_t getU24(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16);
+}
+
+static uint32_t getU32(const uint8_t* in) {
+    return (uint32_t)getU16(in) | ((uint32_t)getU16(in + 2) << 16);
+}
+
+// Tamaño del bloque de datos según el tipo de trama
+static size_t payloadSize(uint8_t frameType, uint8_t frameFlags, uint8_t count) {
+    if (frameType == ADS1220_FRAME_SAMPLES) {
+        size_t record = ADS1220_RECORD_SIZE;
+        if (frameFlags & ADS1220_FRAME_HAS_VALUE) {
+            record += ADS1220_RECORD_VALUE_SIZE;
+        }
+        if (frameFlags & ADS1220_FRAME_HAS_SENSOR_TEMP) {
+            record += ADS1220_RECORD_SENSOR_TEMP_SIZE;
+        }
+        return (size_t)count * record;
+    }
+    if (frameType == ADS1220_FRAME_CONFIG && frameFlags == 0 && count == 1) {
+        return ADS1220_CONFIG_SIZE;
+    }
+    return 0;
+}
+
+// =============================================================================
+// CODIFICACIÓN
+// =============================================================================
+
+uint16_t ADS1220_crc16(const uint8_t* data, size_t length, uint16_t crc) {
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t ADS1220_encodeHeader(uint8_t* out, uint8_t frameType, uint8_t frameFlags,
+                            uint8_t count, uint16_t sequence, uint32_t baseTimestamp) {
+    out[0] = ADS1220_FRAME_SYNC0;
+    out[1] = ADS1220_FRAME_SYNC1;
+    out[2] = ADS1220_PROTOCOL_VERSION;
+    out[3] = frameType;
+    out[4] = frameFlags;
+    out[5] = count;
+    putU16(out + 6, sequence);
+    putU32(out + 8, baseTimestamp);
+    return ADS1220_FRAME_HEADER_SIZE;
+}
+
+size_t ADS1220_encodeRecord(uint8_t* out, const ADS1220_Sample &sample,
+                            uint32_t baseTimestamp, bool includeValue,
+                            bool includeSensorTemp, float sensorTemp) {
+    out[0] = sample.channel;
+    out[1] = sample.flags;
+    putU24(out + 2, sample.timestamp - baseTimestamp);
+    putU24(out + 5, (uint32_t)sample.raw & 0xFFFFFFUL);
+    size_t length = ADS1220_RECORD_SIZE;
+
+    uint32_t bits;
+    if (includeValue) {
+        memcpy(&bits, &sample.value, sizeof(bits));
+        putU32(out + length, bits);
+        length += ADS1220_RECORD_VALUE_SIZE;
+    }
+    if (includeSensorTemp) {
+        memcpy(&bits, &sensorTemp, sizeof(bits));
+        putU32(out + length, bits);
+        length += ADS1220_RECORD_SENSOR_TEMP_SIZE;
+    }
+    return length;
+}
+
+size_t ADS1220_encodeFrame(uint8_t* out, uint16_t sequence, const ADS1220_Sample* samples,
+                           uint8_t count, bool includeValue, uint8_t &encoded) {
+    encoded = 0;
+    if (count == 0) {
+        return 0;
+    }
+    if (count > ADS1220_FRAME_MAX_RECORDS) {
+        count = ADS1220_FRAME_MAX_RECORDS;
+    }
+
+    uint32_t base = samples[0].timestamp;
+    while (encoded < count && (samples[encoded].timestamp - base) <= ADS1220_RECORD_MAX_OFFSET) {
+        encoded++;
+    }
+
+    uint8_t flags = includeValue ? ADS1220_FRAME_HAS_VALUE : 0;
+    size_t length = ADS1220_encodeHeader(out, ADS1220_FRAME_SAMPLES, flags, encoded, sequence, base);
+    for (uint8_t i = 0; i < encoded; i++) {
+        length += ADS1220_encodeRecord(out + length, samples[i], base, includeValue);
+    }
+
+    uint16_t crc = ADS1220_crc16(out + 2, length - 2);
+    putU16(out + length, crc);
+    return length + ADS1220_FRAME_CRC_SIZE;
+}
+
+size_t ADS1220_encodeConfigFrame(uint8_t* out, uint16_t sequence, uint32_t timestamp,
+                                 const ADS1220_Config &config) {
+    size_t length = ADS1220_encodeHeader(out, ADS1220_FRAME_CONFIG, 0, 1, sequence, timestamp);
+    length += ADS1220_encodeConfig(out + length, config);
+
+    uint16_t crc = ADS1220_crc16(out + 2, length - 2);
+    putU16(out + length, crc);
+    return length + ADS1220_FRAME_CRC_SIZE;
+}
+
+// =============================================================================
+// DECODIFICACIÓN
+// =============================================================================
+
+ADS1220_FrameDecoder::ADS1220_FrameDecoder() {
+    _framesDecoded = 0;
+    _crcErrors = 0;
+    _framesLost = 0;
+    reset();
+}
+
+void ADS1220_FrameDecoder::reset() {
+    _length = 0;
+    _expected = 0;
+    _frameType = 0;
+    _frameFlags = 0;
+    _count = 0;
+    _sequence = 0;
+    _haveSequence = false;
+}
+
+bool ADS1220_FrameDecoder::push(uint8_t byte) {
+    _release();
+    _buffer[_length++] = byte;
+    return _scan();
+}
+
+bool ADS1220_FrameDecoder::flush() {
+    _release();
+    while (_length > 0) {
+        if (_scan()) {
+            return true;
+        }
+        if (_length == 0) {
+            break;
+        }
+        // No llegarán más bytes: la trama pendiente no se completará
+        _expected = 0;
+        _discard(1);
+    }
+    return false;
+}
+
+void ADS1220_FrameDecoder::_release() {
+    // Tras una trama completa, sus bytes salen del buffer; los que quedaron
+    // detrás (de una resincronización) se examinan de nuevo
+    if (_expected != 0 && _length >= _expected) {
+        size_t consumed = _expected;
+        _expected = 0;
+        _discard(consumed);
+    }
+}
+
+void ADS1220_FrameDecoder::_discard(size_t count) {
+    // Descarta al menos count bytes y avanza hasta el siguiente 0xA5 candidato
+    while (count < _length && _buffer[count] != ADS1220_FRAME_SYNC0) {
+        count++;
+    }
+    if (count >= _length) {
+        _length = 0;
+        return;
+    }
+    memmove(_buffer, _buffer + count, _length - count);
+    _length -= count;
+}
+
+bool ADS1220_FrameDecoder::_scan() {
+    while (_length > 0) {
+        // Buscar sincronía
+        if (_buffer[0] != ADS1220_FRAME_SYNC0 ||
+            (_length >= 2 && _buffer[1] != ADS1220_FRAME_SYNC1)) {
+            _discard(1);
+            continue;
+        }
+        if (_length < ADS1220_FRAME_HEADER_SIZE) {
+            return false;
+        }
+
+        if (_expected == 0) {
+            uint8_t count = _buffer[5];
+            size_t payload = payloadSize(_buffer[3], _buffer[4], count);
+            if (_buffer[2] != ADS1220_PROTOCOL_VERSION || count == 0 ||
+                count > ADS1220_FRAME_MAX_RECORDS || payload == 0) {
+                // Cabecera inválida: reintentar desde el siguiente byte
+                _discard(1);
+                continue;
+            }
+            _expected = ADS1220_FRAME_HEADER_SIZE + payload + ADS1220_FRAME_CRC_SIZE;
+        }
+
+        if (_length < _expected) {
+            return false;
+        }
+        if (_finishFrame()) {
+            return true;
+        }
+
+        // CRC incorrecto (p. ej. un byte de cabecera corrupto alargó la
+        // trama): la siguiente trama válida puede estar dentro del buffer
+        _expected = 0;
+        _discard(1);
+    }
+    return false;
+}
+
+bool ADS1220_FrameDecoder::_finishFrame() {
+    size_t crcOffset = _expected - ADS1220_FRAME_CRC_SIZE;
+    uint16_t crc = ADS1220_crc16(_buffer + 2, crcOffset - 2);
+    if (crc != getU16(_buffer + crcOffset)) {
+        _crcErrors++;
+        return false;
+    }
+
+    uint16_t sequence = getU16(_buffer + 6);
+    if (_haveSequence) {
+        uint16_t gap = (uint16_t)(sequence - _sequence - 1);
+        _framesLost += gap;
+    }
+
+    _frameType = _buffer[3];
+    _frameFlags = _buffer[4];
+    _count = _buffer[5];
+    _sequence = sequence;
+    _haveSequence = true;
+    _framesDecoded++;
+    return true;
+}
+
+bool ADS1220_FrameDecoder::sample(uint8_t index, ADS1220_Sample &out) const {
+    if (_frameType != ADS1220_FRAME_SAMPLES || index >= _count) {
+        return false;
+    }
+
+    bool withValue = hasValue();
+    const uint8_t* record = payload() + (size_t)index * _recordSize();
+    uint32_t base = getU32(_buffer + 8);
+
+    out.channel = record[0];
+    out.flags = record[1];
+    out.timestamp = base + getU24(record + 2);
+
+    // Extender signo de 24 a 32 bits
+    uint32_t raw = getU24(record + 5);
+    if (raw & 0x00800000UL) {
+        raw |= 0xFF000000UL;
+    }
+    out.raw = (int32_t)raw;
+
+    if (withValue) {
+        uint32_t bits = getU32(record + 8);
+        memcpy(&out.value, &bits, sizeof(bits));
+    } else {
+        out.value = 0.0f;
+        out.flags &= ~ADS1220_SAMPLE_VALUE_VALID;
+    }
+    return true;
+}
+
+bool ADS1220_FrameDecoder::sensorTemperature(uint8_t index, float &out) const {
+    if (_frameType != ADS1220_FRAME_SAMPLES || !hasSensorTemp() || index >= _count) {
+        return false;
+    }
+
+    const uint8_t* record = payload() + (size_t)index * _recordSize();
+    size_t offset = ADS1220_RECORD_SIZE + (hasValue() ? ADS1220_RECORD_VALUE_SIZE : 0);
+    uint32_t bits = getU32(record + offset);
+    memcpy(&out, &bits, sizeof(out));
+    return true;
+}
+
+size_t ADS1220_FrameDecoder::_recordSize() const {
+    return payloadSize(ADS1220_FRAME_SAMPLES, _frameFlags, 1);
+}
+
+bool ADS1220_FrameDecoder::config(ADS1220_Config &out) const {
+    if (_frameType != ADS1220_FRAME_CONFIG) {
+        return false;
+    }
+    return ADS1220_decodeConfig(payload(), payloadLength(), out);
+}
+
+uint32_t ADS1220_FrameDecoder::baseTimestamp() const {
+    return getU32(_buffer + 8);
+}
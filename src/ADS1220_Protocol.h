@@ -0,0 +1,204 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Protocolo binario de streaming
+ *
+ * Formato de trama compacto para enviar registros de muestras a la velocidad
+ * completa del ADC. Este archivo no depende de Arduino: se compila igual en el
+ * microcontrolador (codificador) y en el host (decodificador, ver extras/).
+ *
+ * Trama (little-endian):
+ *   Offset  Tamaño  Campo
+ *   0       2       Sincronía 0xA5 0x5A
+ *   2       1       Versión del protocolo (ADS1220_PROTOCOL_VERSION)
+ *   3       1       Tipo de trama (ADS1220_FRAME_SAMPLES o ADS1220_FRAME_CONFIG)
+ *   4       1       Banderas de trama (ADS1220_FRAME_HAS_*)
+ *   5       1       Número de registros N (1 .. ADS1220_FRAME_MAX_RECORDS)
+ *   6       2       Número de secuencia (uint16, +1 por trama)
+ *   8       4       Timestamp base [µs] (uint32, micros() del primer registro)
+ *   12      N×R     Registros
+ *   12+N×R  2       CRC-16/CCITT-FALSE de los bytes 2 .. 12+N×R-1
+ *
+ * Registro (R = 8 bytes, +4 con valor de ingeniería, +4 con temperatura del
+ * sensor de flujo):
+ *   0       1       Canal
+ *   1       1       Banderas de muestra (ADS1220_SAMPLE_*)
+ *   2       3       Timestamp relativo al base [µs] (uint24)
+ *   5       3       Código del ADC (int24, complemento a 2)
+ *   8       4       Valor de ingeniería (float32) [ADS1220_FRAME_HAS_VALUE]
+ *   8/12    4       Temperatura del sensor de flujo [°C] (float32) con la que
+ *                   se calculó el valor [ADS1220_FRAME_HAS_SENSOR_TEMP]
+ *
+ * Trama de configuración (N = 1, sin banderas): el bloque de datos es la
+ * imagen de ADS1220_encodeConfig() (ADS1220_CONFIG_SIZE bytes) vigente desde
+ * el timestamp base. Precede a las muestras de una grabación para poder
+ * reprocesarlas después con la misma configuración (ver ADS1220_Replay.h).
+ ******************************************************************************/
+
+#ifndef ADS1220_PROTOCOL_H
+#define ADS1220_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ADS1220_Config.h"
+
+// ===== CONSTANTES DEL PROTOCOLO =====
+#define ADS1220_FRAME_SYNC0             0xA5
+#define ADS1220_FRAME_SYNC1             0x5A
+#define ADS1220_PROTOCOL_VERSION        1
+
+#define ADS1220_FRAME_SAMPLES           0x01    // Trama de registros de muestras
+#define ADS1220_FRAME_CONFIG            0x02    // Trama con la imagen de configuración
+
+#define ADS1220_FRAME_HAS_VALUE         0x01    // Registros con valor float32
+#define ADS1220_FRAME_HAS_SENSOR_TEMP   0x02    // Registros con temperatura del sensor de flujo
+
+#define ADS1220_FRAME_HEADER_SIZE       12
+#define ADS1220_FRAME_CRC_SIZE          2
+#define ADS1220_RECORD_SIZE             8
+#define ADS1220_RECORD_VALUE_SIZE       4
+#define ADS1220_RECORD_SENSOR_TEMP_SIZE 4
+#define ADS1220_FRAME_MAX_RECORDS       32
+#define ADS1220_FRAME_MAX_SIZE          (ADS1220_FRAME_HEADER_SIZE + \
+                                         ADS1220_FRAME_MAX_RECORDS * (ADS1220_RECORD_SIZE + ADS1220_RECORD_VALUE_SIZE + \
+                                                                      ADS1220_RECORD_SENSOR_TEMP_SIZE) + \
+                                         ADS1220_FRAME_CRC_SIZE)
+#define ADS1220_RECORD_MAX_OFFSET       0xFFFFFFUL  // µs (~16.7 s por trama)
+#define ADS1220_CONFIG_FRAME_SIZE       (ADS1220_FRAME_HEADER_SIZE + ADS1220_CONFIG_SIZE + ADS1220_FRAME_CRC_SIZE)
+
+#if ADS1220_CONFIG_FRAME_SIZE > ADS1220_FRAME_MAX_SIZE
+#error "La trama de configuración no cabe en el buffer del decodificador"
+#endif
+
+// ===== BANDERAS DE MUESTRA =====
+#define ADS1220_SAMPLE_VALUE_VALID      0x01    // value contiene el valor de ingeniería
+#define ADS1220_SAMPLE_HEAT_FLUX        0x02    // value en W/m² (si no, °C)
+#define ADS1220_SAMPLE_CHOPPED          0x04    // Par de conversiones en modo chopper
+#define ADS1220_SAMPLE_OFFSET_CORRECTED 0x08    // Offset calibrado restado
+#define ADS1220_SAMPLE_OVERRUN          0x10    // Se perdieron muestras antes de esta
+#define ADS1220_SAMPLE_CONFIG_FAULT     0x20    // Registros del ADC alterados (ya restaurados)
+#define ADS1220_SAMPLE_SENSOR_FAULT     0x40    // Canal con sensor abierto, en corto o fuera de rango
+
+// ===== REGISTRO DE MUESTRA =====
+struct ADS1220_Sample {
+    uint32_t timestamp;     // micros() del primer poll() que vio la conversión lista
+    int32_t raw;            // Código del ADC (tras corrección de offset)
+    float value;            // Temperatura [°C] o flujo térmico [W/m²]
+    uint8_t channel;        // 0 = AIN0-AIN1, 1 = AIN2-AIN3
+    uint8_t flags;          // ADS1220_SAMPLE_*
+};
+
+// ===== CODIFICACIÓN =====
+
+/**
+ * @brief Actualiza un CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+ */
+uint16_t ADS1220_crc16(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF);
+
+/**
+ * @brief Escribe la cabecera de una trama de muestras
+ * @return Bytes escritos (ADS1220_FRAME_HEADER_SIZE)
+ */
+size_t ADS1220_encodeHeader(uint8_t* out, uint8_t frameType, uint8_t frameFlags,
+                            uint8_t count, uint16_t sequence, uint32_t baseTimestamp);
+
+/**
+ * @brief Escribe un registro de muestra
+ * @param includeSensorTemp true si la trama lleva ADS1220_FRAME_HAS_SENSOR_TEMP
+ * @return Bytes escritos (8, 12 o 16)
+ */
+size_t ADS1220_encodeRecord(uint8_t* out, const ADS1220_Sample &sample,
+                            uint32_t baseTimestamp, bool includeValue,
+                            bool includeSensorTemp = false, float sensorTemp = 0.0f);
+
+/**
+ * @brief Codifica una trama completa en un buffer
+ * @param out Buffer de salida (al menos ADS1220_FRAME_MAX_SIZE bytes)
+ * @param samples Registros a codificar
+ * @param count Número de registros; se trunca a ADS1220_FRAME_MAX_RECORDS y
+ *              antes del primer registro a más de 16.7 s del timestamp base
+ * @param encoded Número de registros que entraron en la trama
+ * @return Longitud de la trama en bytes (0 si count == 0)
+ */
+size_t ADS1220_encodeFrame(uint8_t* out, uint16_t sequence, const ADS1220_Sample* samples,
+                           uint8_t count, bool includeValue, uint8_t &encoded);
+
+/**
+ * @brief Codifica una trama de configuración
+ * @param out Buffer de salida (al menos ADS1220_CONFIG_FRAME_SIZE bytes)
+ * @param timestamp Instante desde el que rige la configuración [µs]
+ * @return Longitud de la trama (ADS1220_CONFIG_FRAME_SIZE)
+ */
+size_t ADS1220_encodeConfigFrame(uint8_t* out, uint16_t sequence, uint32_t timestamp,
+                                 const ADS1220_Config &config);
+
+// ===== DECODIFICACIÓN =====
+
+/**
+ * @brief Decodificador incremental de tramas (byte a byte)
+ *
+ * Se resincroniza solo tras bytes corruptos o perdidos: tras una cabecera
+ * inválida o un CRC incorrecto vuelve a buscar la sincronía en los bytes ya
+ * recibidos, así que una trama dañada no arrastra a la siguiente. Cuenta
+ * errores de CRC y tramas perdidas según los saltos del número de secuencia.
+ */
+class ADS1220_FrameDecoder {
+public:
+    ADS1220_FrameDecoder();
+
+    /**
+     * @brief Procesa un byte recibido
+     * @return true cuando se completa una trama válida
+     */
+    bool push(uint8_t byte);
+
+    /**
+     * @brief Fin de la entrada: extrae la siguiente trama que quede en el buffer
+     * @return true si había otra trama válida
+     * 
+     * Tras una resincronización el buffer puede contener varias tramas
+     * completas y push() entrega una por byte. Al llegar a EOF se llama en
+     * bucle hasta que devuelve false; una trama incompleta al frente (p. ej.
+     * una cabecera corrupta que la alargó) se descarta para buscar detrás.
+     */
+    bool flush();
+
+    void reset();
+
+    // Datos de la última trama válida
+    uint8_t frameType() const { return _frameType; }
+    uint8_t recordCount() const { return _count; }
+    uint16_t sequence() const { return _sequence; }
+    uint32_t baseTimestamp() const;
+    bool hasValue() const { return (_frameFlags & ADS1220_FRAME_HAS_VALUE) != 0; }
+    bool hasSensorTemp() const { return (_frameFlags & ADS1220_FRAME_HAS_SENSOR_TEMP) != 0; }
+    const uint8_t* payload() const { return _buffer + ADS1220_FRAME_HEADER_SIZE; }
+    size_t payloadLength() const { return _expected - ADS1220_FRAME_HEADER_SIZE - ADS1220_FRAME_CRC_SIZE; }
+    bool sample(uint8_t index, ADS1220_Sample &out) const;
+    bool sensorTemperature(uint8_t index, float &out) const;  // false sin ADS1220_FRAME_HAS_SENSOR_TEMP
+    bool config(ADS1220_Config &out) const;                   // false si no es ADS1220_FRAME_CONFIG
+
+    // Estadísticas del enlace
+    uint32_t framesDecoded() const { return _framesDecoded; }
+    uint32_t crcErrors() const { return _crcErrors; }
+    uint32_t framesLost() const { return _framesLost; }
+
+private:
+    uint8_t _buffer[ADS1220_FRAME_MAX_SIZE];
+    size_t _length;
+    size_t _expected;
+    uint8_t _frameType;
+    uint8_t _frameFlags;
+    uint8_t _count;
+    uint16_t _sequence;
+    bool _haveSequence;
+    uint32_t _framesDecoded;
+    uint32_t _crcErrors;
+    uint32_t _framesLost;
+
+    bool _scan();
+    void _release();
+    size_t _recordSize() const;
+    void _discard(size_t count);
+    bool _finishFrame();
+};
+
+#endif // ADS1220_PROTOCOL_H
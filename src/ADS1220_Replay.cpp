@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Reproducción de grabaciones de códigos crudos
+ ******************************************************************************/
+
+#include "ADS1220_Replay.h"
+#include <string.h>
+
+// =============================================================================
+// CONFIGURACIÓN
+// =============================================================================
+
+ADS1220_Replay::ADS1220_Replay(ADS1220_NTC_Extended &adc) : _adc(adc) {
+    _callback = nullptr;
+    _context = nullptr;
+    reset();
+}
+
+void ADS1220_Replay::setSampleCallback(ADS1220_ReplayCallback callback, void* context) {
+    _callback = callback;
+    _context = context;
+}
+
+void ADS1220_Replay::reset() {
+    _decoder.reset();
+    _samples = 0;
+    _configs = 0;
+    _rejected = 0;
+    _compared = 0;
+    _mismatches = 0;
+    _processTime_us = 0;
+    _firstTimestamp = 0;
+    _lastTimestamp = 0;
+}
+
+// =============================================================================
+// REPRODUCCIÓN
+// =============================================================================
+
+bool ADS1220_Replay::push(uint8_t byte) {
+    if (!_decoder.push(byte)) {
+        return false;
+    }
+    _handleFrame();
+    return true;
+}
+
+uint32_t ADS1220_Replay::flush() {
+    uint32_t frames = 0;
+    while (_decoder.flush()) {
+        _handleFrame();
+        frames++;
+    }
+    return frames;
+}
+
+void ADS1220_Replay::_handleFrame() {
+    if (_decoder.frameType() == ADS1220_FRAME_CONFIG) {
+        ADS1220_Config config;
+        if (_decoder.config(config)) {
+            _adc.importConfiguration(config);
+            _configs++;
+        } else {
+            _rejected++;
+        }
+    } else {
+        _replayFrame();
+    }
+}
+
+uint32_t ADS1220_Replay::run(Stream* input) {
+    uint32_t before = _samples;
+    while (input->available() > 0) {
+        int c = input->read();
+        if (c < 0) {
+            break;
+        }
+        push((uint8_t)c);
+    }
+    flush();
+    return _samples - before;
+}
+
+void ADS1220_Replay::_replayFrame() {
+    // Se cronometra la trama completa: micros() por muestra no tiene resolución
+    uint32_t start = micros();
+
+    for (uint8_t i = 0; i < _decoder.recordCount(); i++) {
+        ADS1220_Sample recorded;
+        ADS1220_Sample replayed;
+        float sensorTemp = NAN;
+        _decoder.sensorTemperature(i, sensorTemp);  // Solo en tramas con flujo térmico
+        if (!_decoder.sample(i, recorded) || !_adc.replaySample(recorded, replayed, sensorTemp)) {
+            _rejected++;
+            continue;
+        }
+
+        if (_samples == 0) {
+            _firstTimestamp = recorded.timestamp;
+        }
+        _lastTimestamp = recorded.timestamp;
+        _samples++;
+
+        // OVERRUN depende de quién vació el buffer, no del pipeline
+        if (_decoder.hasValue()) {
+            uint8_t mask = (uint8_t)~ADS1220_SAMPLE_OVERRUN;
+            bool same = (recorded.flags & mask) == (replayed.flags & mask);
+            if (same && (recorded.flags & ADS1220_SAMPLE_VALUE_VALID)) {
+                same = memcmp(&recorded.value, &replayed.value, sizeof(float)) == 0;
+            }
+            _compared++;
+            if (!same) {
+                _mismatches++;
+            }
+        }
+
+        if (_callback != nullptr) {
+            _callback(recorded, replayed, _context);
+        }
+    }
+
+    _processTime_us += micros() - start;
+}
+
+// =============================================================================
+// RESULTADOS
+// =============================================================================
+
+float ADS1220_Replay::getThroughput() const {
+    if (_processTime_us == 0) {
+        return 0.0f;
+    }
+    return (float)_samples * 1e6f / (float)_processTime_us;
+}
+
+float ADS1220_Replay::getSpeedup() const {
+    if (_processTime_us == 0) {
+        return 0.0f;
+    }
+    return (float)getRecordedSpan_us() / (float)_processTime_us;
+}
+
+void ADS1220_Replay::printSummary(Stream* out) const {
+    out->println(F("=== Reproducción ==="));
+    out->print(F("Muestras: ")); out->print((unsigned long)_samples);
+    out->print(F("  Configuraciones: ")); out->print((unsigned long)_configs);
+    out->print(F("  Rechazadas: ")); out->println((unsigned long)_rejected);
+    out->print(F("Tiempo de CPU: ")); out->print((unsigned long)_processTime_us);
+    out->print(F(" µs  Grabado: ")); out->print((unsigned long)getRecordedSpan_us());
+    out->println(F(" µs"));
+    out->print(F("Throughput: ")); out->print(getThroughput(), 0);
+    out->print(F(" muestras/s  (x")); out->print(getSpeedup(), 1);
+    out->println(F(" tiempo real)"));
+    if (_compared > 0) {
+        out->print(F("Comparadas: ")); out->print((unsigned long)_compared);
+        out->print(F("  Diferentes: ")); out->println((unsigned long)_mismatches);
+    } else {
+        out->println(F("Sin valores grabados: no se comparó"));
+    }
+    out->print(F("Tramas: ")); out->print((unsigned long)_decoder.framesDecoded());
+    out->print(F("  Errores CRC: ")); out->print((unsigned long)_decoder.crcErrors());
+    out->print(F("  Tramas perdidas: ")); out->println((unsigned long)_decoder.framesLost());
+}
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Reproducción de grabaciones de códigos crudos
+ *
+ * Una grabación es el mismo streaming binario de ADS1220_Protocol.h: una
+ * trama de configuración (writeConfigFrame()) seguida de tramas de muestras
+ * (writeBinaryFrame()), guardada en un archivo o en una tarjeta SD.
+ * ADS1220_Replay la decodifica, aplica cada configuración con
+ * importConfiguration() y pasa cada código por replaySample(), es decir, por
+ * el mismo pipeline que una conversión real, sin esperar al ADC: el
+ * reprocesado corre tan rápido como permita la CPU.
+ *
+ * Sirve para:
+ *   - Medir el throughput de conversión, filtros, estadísticas y eventos con
+ *     una entrada fija (muestras/s y factor sobre tiempo real)
+ *   - Comparar bit a bit: si la grabación se hizo con includeValue = true, el
+ *     valor de cada muestra reprocesada se compara con el grabado
+ *   - Repetir en el host (con ADS1220_MockTransport) lo que pasó en campo
+ *
+ * Las tramas de flujo térmico llevan en cada registro la temperatura del
+ * sensor con la que se calculó (puede cambiar en cada readHeatFlux()); la
+ * imagen de configuración lleva el resto de entradas del cálculo.
+ *
+ * Los códigos grabados ya llevan restado el offset y combinado el chopper,
+ * así que no se repiten conversiones auxiliares (offset, diagnóstico). Para
+ * un resultado idéntico, el driver debe empezar en el mismo estado que al
+ * grabar (filtros, estadísticas y eventos configurados igual, sin historia).
+ * Mientras corre no debe haber otra lectura en curso.
+ *
+ * La comparación bit a bit es exacta en la misma plataforma; entre el
+ * microcontrolador y el host las funciones de libm (log, exp) pueden
+ * diferir en el último bit.
+ ******************************************************************************/
+
+#ifndef ADS1220_REPLAY_H
+#define ADS1220_REPLAY_H
+
+#include <Arduino.h>
+#include "ADS1220_NTC_Extended.h"
+#include "ADS1220_Protocol.h"
+
+/**
+ * @brief Recibe cada muestra reprocesada
+ * @param recorded Registro tal como se grabó
+ * @param replayed Registro a la salida del pipeline
+ * @param context Puntero de usuario pasado a setSampleCallback()
+ */
+typedef void (*ADS1220_ReplayCallback)(const ADS1220_Sample &recorded,
+                                       const ADS1220_Sample &replayed, void* context);
+
+class ADS1220_Replay {
+public:
+    /**
+     * @brief Constructor
+     * @param adc Driver ya inicializado con begin() (en el host, con ADS1220_MockTransport)
+     */
+    ADS1220_Replay(ADS1220_NTC_Extended &adc);
+
+    /**
+     * @brief Función llamada con cada muestra reprocesada (nullptr = ninguna)
+     *
+     * Su tiempo de ejecución cuenta en getProcessTime_us().
+     */
+    void setSampleCallback(ADS1220_ReplayCallback callback, void* context = nullptr);
+
+    /**
+     * @brief Procesa un byte de la grabación
+     * @return true si completó una trama válida (configuración o muestras)
+     */
+    bool push(uint8_t byte);
+
+    /**
+     * @brief Procesa las tramas completas que quedan en el decodificador
+     * @return Tramas procesadas
+     * 
+     * Tras una resincronización pueden quedar varias; se llama al final de
+     * la grabación si se alimenta con push().
+     */
+    uint32_t flush();
+
+    /**
+     * @brief Procesa todos los bytes disponibles en input y, al agotarse, flush()
+     * @return Muestras reprocesadas en esta llamada
+     */
+    uint32_t run(Stream* input);
+
+    /**
+     * @brief Reinicia el decodificador y los contadores (no el driver)
+     */
+    void reset();
+
+    // ===== RESULTADOS =====
+    uint32_t getSamples() const { return _samples; }
+    uint32_t getConfigs() const { return _configs; }
+    uint32_t getRejected() const { return _rejected; }
+    uint32_t getCompared() const { return _compared; }
+    uint32_t getMismatches() const { return _mismatches; }
+    uint32_t getProcessTime_us() const { return _processTime_us; }
+    uint32_t getRecordedSpan_us() const { return _samples > 0 ? _lastTimestamp - _firstTimestamp : 0; }
+
+    /**
+     * @brief Muestras reprocesadas por segundo de CPU
+     */
+    float getThroughput() const;
+
+    /**
+     * @brief Duración grabada / tiempo de reprocesado (> 1 = más rápido que tiempo real)
+     */
+    float getSpeedup() const;
+
+    const ADS1220_FrameDecoder &decoder() const { return _decoder; }
+
+    /**
+     * @brief Imprime muestras, throughput, comparación y errores del enlace
+     */
+    void printSummary(Stream* out) const;
+
+private:
+    ADS1220_NTC_Extended &_adc;
+    ADS1220_FrameDecoder _decoder;
+    ADS1220_ReplayCallback _callback;
+    void* _context;
+
+    uint32_t _samples;
+    uint32_t _configs;
+    uint32_t _rejected;                 // Canal inválido o lectura en curso
+    uint32_t _compared;
+    uint32_t _mismatches;
+    uint32_t _processTime_us;
+    uint32_t _firstTimestamp;
+    uint32_t _lastTimestamp;
+
+    void _handleFrame();
+    void _replayFrame();
+};
+
+#endif // ADS1220_REPLAY_H
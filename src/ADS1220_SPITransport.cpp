@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Transporte SPI de Arduino
+ ******************************************************************************/
+
+#include "ADS1220_SPITransport.h"
+#include <string.h>
+
+ADS1220_SPITransport::ADS1220_SPITransport(uint8_t csPin, SPIClass *spi, uint32_t clockHz) {
+    _csPin = csPin;
+    _spi = spi;
+    _clockHz = clockHz;
+}
+
+bool ADS1220_SPITransport::begin() {
+    if (_spi == nullptr) {
+        return false;
+    }
+    pinMode(_csPin, OUTPUT);
+    csHigh();
+    _spi->begin();
+    return true;
+}
+
+void ADS1220_SPITransport::transfer(const uint8_t* tx, uint8_t* rx, uint8_t length) {
+    _spi->beginTransaction(SPISettings(_clockHz, MSBFIRST, SPI_MODE1));
+    _transferBytes(tx, rx, length);
+    _spi->endTransaction();
+}
+
+void ADS1220_SPITransport::transferQueue(const ADS1220_Transaction* list, uint8_t count) {
+    _spi->beginTransaction(SPISettings(_clockHz, MSBFIRST, SPI_MODE1));
+    for (uint8_t i = 0; i < count; i++) {
+        _transferBytes(list[i].tx, list[i].rx, list[i].length);
+    }
+    _spi->endTransaction();
+}
+
+void ADS1220_SPITransport::_transferBytes(const uint8_t* tx, uint8_t* rx, uint8_t length) {
+    if (length > ADS1220_TRANSFER_MAX_LENGTH) {
+        length = ADS1220_TRANSFER_MAX_LENGTH;
+    }
+
+    // Transferencia de bloque in-place (usa la FIFO del periférico en ESP32)
+    uint8_t buffer[ADS1220_TRANSFER_MAX_LENGTH];
+    if (tx != nullptr) {
+        memcpy(buffer, tx, length);
+    } else {
+        memset(buffer, 0x00, length);
+    }
+
+    csLow();
+    _spi->transfer(buffer, length);
+    csHigh();
+
+    if (rx != nullptr) {
+        memcpy(rx, buffer, length);
+    }
+}
+
+void ADS1220_SPITransport::csLow() {
+    digitalWrite(_csPin, LOW);
+    delayMicroseconds(1);
+}
+
+void ADS1220_SPITransport::csHigh() {
+    delayMicroseconds(1);
+    digitalWrite(_csPin, HIGH);
+}
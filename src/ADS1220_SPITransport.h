@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Transporte SPI de Arduino
+ *
+ * Backend por defecto: SPIClass con SPI_MODE1 a 1 MHz y CS por digitalWrite.
+ * csLow()/csHigh() son virtuales para que una subclase use acceso directo a
+ * los registros GPIO sin reescribir las transferencias.
+ ******************************************************************************/
+
+#ifndef ADS1220_SPI_TRANSPORT_H
+#define ADS1220_SPI_TRANSPORT_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "ADS1220_Transport.h"
+
+#define ADS1220_SPI_CLOCK_HZ            1000000UL
+
+class ADS1220_SPITransport : public ADS1220_Transport {
+public:
+    /**
+     * @brief Constructor
+     * @param csPin Pin CS del ADS1220
+     * @param spi Instancia SPI (se puede cambiar con setSPI() antes de begin())
+     * @param clockHz Frecuencia de SCLK
+     */
+    ADS1220_SPITransport(uint8_t csPin, SPIClass *spi = &SPI, uint32_t clockHz = ADS1220_SPI_CLOCK_HZ);
+
+    void setSPI(SPIClass *spi) { _spi = spi; }
+    void setClock(uint32_t clockHz) { _clockHz = clockHz; }
+
+    bool begin() override;
+    void transfer(const uint8_t* tx, uint8_t* rx, uint8_t length) override;
+
+    /**
+     * @brief Ejecuta la lista bajo una sola beginTransaction(), con CS
+     *        alternado entre transacciones
+     */
+    void transferQueue(const ADS1220_Transaction* list, uint8_t count) override;
+
+protected:
+    SPIClass *_spi;
+    uint8_t _csPin;
+    uint32_t _clockHz;
+
+    virtual void csLow();
+    virtual void csHigh();
+
+private:
+    void _transferBytes(const uint8_t* tx, uint8_t* rx, uint8_t length);
+};
+
+#endif // ADS1220_SPI_TRANSPORT_H
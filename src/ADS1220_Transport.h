@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Interfaz de transporte SPI
+ *
+ * El driver no llama directamente a SPIClass: cada comando, acceso a registro
+ * o lectura de datos es una transacción (CS bajo, N bytes full-duplex, CS
+ * alto) que se entrega a un ADS1220_Transport. Así un backend con DMA o con
+ * manejo de CS por registros se sustituye sin tocar el código de medición.
+ *
+ * Backends incluidos:
+ *   - ADS1220_SPITransport  (ADS1220_SPITransport.h): SPIClass de Arduino,
+ *     usado por defecto en begin(SPIClass*)
+ *   - ADS1220_MockTransport (ADS1220_MockTransport.h): ADS1220 emulado para
+ *     pruebas en host, sin hardware
+ *
+ * Este archivo no depende de Arduino.
+ ******************************************************************************/
+
+#ifndef ADS1220_TRANSPORT_H
+#define ADS1220_TRANSPORT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Longitud máxima de una transacción (WREG de 4 registros = 5 bytes)
+#define ADS1220_TRANSFER_MAX_LENGTH     8
+
+// ===== TRANSACCIÓN =====
+struct ADS1220_Transaction {
+    const uint8_t* tx;      // Bytes a enviar (nullptr = enviar 0x00)
+    uint8_t* rx;            // Bytes recibidos (nullptr = descartar)
+    uint8_t length;         // 1 .. ADS1220_TRANSFER_MAX_LENGTH
+};
+
+// ===== INTERFAZ =====
+class ADS1220_Transport {
+public:
+    virtual ~ADS1220_Transport() {}
+
+    /**
+     * @brief Inicializa el bus y el pin CS
+     * @return true si el transporte quedó listo
+     */
+    virtual bool begin() { return true; }
+
+    /**
+     * @brief Ejecuta una transacción: CS bajo, length bytes, CS alto
+     * @param tx Bytes a enviar (nullptr = 0x00)
+     * @param rx Bytes recibidos (nullptr = descartar; puede ser igual a tx)
+     */
+    virtual void transfer(const uint8_t* tx, uint8_t* rx, uint8_t length) = 0;
+
+    /**
+     * @brief Ejecuta una lista de transacciones seguidas
+     *
+     * La implementación por defecto llama a transfer() para cada una; un
+     * backend puede agruparlas bajo una sola reserva del bus o encolarlas
+     * en DMA.
+     */
+    virtual void transferQueue(const ADS1220_Transaction* list, uint8_t count) {
+        for (uint8_t i = 0; i < count; i++) {
+            transfer(list[i].tx, list[i].rx, list[i].length);
+        }
+    }
+
+    /**
+     * @brief Indica si el transporte conoce el estado de DRDY
+     *
+     * Si devuelve false, el driver usa el pin DRDY o el tiempo de conversión.
+     */
+    virtual bool hasDataReady() { return false; }
+
+    /**
+     * @brief Dato de conversión listo (solo si hasDataReady())
+     */
+    virtual bool dataReady() { return true; }
+};
+
+#endif // ADS1220_TRANSPORT_H
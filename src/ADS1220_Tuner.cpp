@@ -0,0 +1,264 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Caracterización de ruido y ajuste automático
+ ******************************************************************************/
+
+#include "ADS1220_Tuner.h"
+
+// Conversiones por segundo de cada data rate en modo normal (para la tabla)
+static const uint16_t s_dataRateSPS[7] = {20, 45, 90, 175, 330, 600, 1000};
+
+// =============================================================================
+// DESVIACIÓN DE ALLAN EN CASCADA
+// =============================================================================
+
+// Allan no solapada a τ = 2^n muestras: cada nivel recibe las medias de
+// bloque del anterior por parejas y acumula (ȳ[i+1] - ȳ[i])²
+class AllanCascade {
+public:
+    AllanCascade() {
+        for (uint8_t n = 0; n < ADS1220_TUNE_LEVELS; n++) {
+            _hasPending[n] = false;
+            _hasPrevious[n] = false;
+            _sumSq[n] = 0.0f;
+            _pairs[n] = 0;
+        }
+    }
+
+    void add(float value) {
+        for (uint8_t n = 0; n < ADS1220_TUNE_LEVELS; n++) {
+            if (_hasPrevious[n]) {
+                float diff = value - _previous[n];
+                _sumSq[n] += diff * diff;
+                _pairs[n]++;
+            }
+            _previous[n] = value;
+            _hasPrevious[n] = true;
+
+            // El bloque de este nivel se completa con la segunda media
+            if (!_hasPending[n]) {
+                _pending[n] = value;
+                _hasPending[n] = true;
+                return;
+            }
+            value = 0.5f * (_pending[n] + value);
+            _hasPending[n] = false;
+        }
+    }
+
+    // σ_A(τ) = sqrt(½·⟨(ȳ[i+1] - ȳ[i])²⟩); 0 si el nivel no tiene pares
+    float deviation(uint8_t n) const {
+        return (_pairs[n] > 0) ? sqrt(_sumSq[n] / (2.0f * (float)_pairs[n])) : 0.0f;
+    }
+
+private:
+    float _pending[ADS1220_TUNE_LEVELS];
+    float _previous[ADS1220_TUNE_LEVELS];
+    float _sumSq[ADS1220_TUNE_LEVELS];
+    uint16_t _pairs[ADS1220_TUNE_LEVELS];
+    bool _hasPending[ADS1220_TUNE_LEVELS];
+    bool _hasPrevious[ADS1220_TUNE_LEVELS];
+};
+
+// =============================================================================
+// CONFIGURACIÓN
+// =============================================================================
+
+ADS1220_Tuner::ADS1220_Tuner(ADS1220_NTC_Extended &adc) : _adc(adc) {
+    _dataRateMask = 0x7F;
+    _gainMask = 0xFF;
+    _pgaBypass = true;
+    _samples = ADS1220_TUNE_SAMPLES;
+}
+
+void ADS1220_Tuner::setSweep(uint8_t dataRateMask, uint8_t gainMask, bool pgaBypass) {
+    _dataRateMask = dataRateMask & 0x7F;
+    _gainMask = gainMask;
+    _pgaBypass = pgaBypass;
+}
+
+void ADS1220_Tuner::setSampleCount(uint16_t samples) {
+    _samples = (samples < 8) ? 8 : samples;
+}
+
+void ADS1220_Tuner::apply(const ADS1220_TuneResult &result) {
+    _adc.setDataRate(result.dataRate);
+    _adc.setGain(result.gain);
+    _adc.setPGABypass(result.pgaBypass);
+    _adc.setMovingAverageSize(result.avgSize);
+}
+
+// =============================================================================
+// MEDICIÓN
+// =============================================================================
+
+bool ADS1220_Tuner::_read(ADS1220_Channel channel, ADS1220_Sample &sample, uint32_t &duration_us) {
+    uint32_t start = micros();
+    if (!_adc.startRead(channel)) {
+        return false;
+    }
+
+    ADS1220_ReadStatus status;
+    while ((status = _adc.poll(sample)) == READ_PENDING) {
+        yield();
+    }
+    duration_us = micros() - start;
+    return status == READ_READY;
+}
+
+bool ADS1220_Tuner::measure(ADS1220_Channel channel, uint8_t dataRate, uint8_t gain, bool pgaBypass,
+                            ADS1220_TuneResult &result) {
+    result.dataRate = dataRate;
+    result.gain = gain;
+    result.pgaBypass = pgaBypass;
+    result.avgSize = 1;
+    result.rms_uV = 0.0f;
+    result.enob = 0.0f;
+    result.readTime_ms = 0.0f;
+    result.noise = 0.0f;
+    result.latency_ms = 0.0f;
+    result.valid = false;
+    for (uint8_t n = 0; n < ADS1220_TUNE_LEVELS; n++) {
+        result.allan[n] = 0.0f;
+    }
+
+    _adc.setDataRate(dataRate);
+    _adc.setGain(gain);
+    _adc.setPGABypass(pgaBypass);
+
+    ADS1220_Sample sample;
+    uint32_t duration;
+    for (uint8_t i = 0; i < ADS1220_TUNE_DISCARD; i++) {
+        if (!_read(channel, sample, duration)) {
+            return false;
+        }
+    }
+
+    AllanCascade codes;
+    AllanCascade values;
+    uint32_t totalTime = 0;
+    for (uint16_t i = 0; i < _samples; i++) {
+        if (!_read(channel, sample, duration)) {
+            return false;
+        }
+        // Saturada (fuera de rango para esta ganancia) o sin valor de ingeniería
+        if (!(sample.flags & ADS1220_SAMPLE_VALUE_VALID) ||
+            sample.raw >= ADS1220_SATURATION_CODE || sample.raw <= -ADS1220_SATURATION_CODE) {
+            return false;
+        }
+        codes.add((float)sample.raw);
+        values.add(sample.value);
+        totalTime += duration;
+    }
+
+    // Ruido de una conversión en códigos; FSR = 2·VREF/G = 2^24 códigos
+    float sigmaCode = codes.deviation(0);
+    float gainValue = (float)(1 << ((gain >> 1) & 0x07));
+    result.rms_uV = sigmaCode * ADS1220_VREF / (gainValue * (float)ADS1220_MAX_CODE) * 1e6f;
+    result.enob = (sigmaCode > 1.0f) ? 24.0f - log(sigmaCode) / log(2.0f) : 24.0f;
+    for (uint8_t n = 0; n < ADS1220_TUNE_LEVELS; n++) {
+        result.allan[n] = values.deviation(n);
+    }
+    result.readTime_ms = (float)totalTime / (float)_samples * 1e-3f;
+    result.noise = result.allan[0];
+    result.latency_ms = result.readTime_ms;
+    result.valid = true;
+    return true;
+}
+
+// =============================================================================
+// BARRIDO Y RECOMENDACIÓN
+// =============================================================================
+
+bool ADS1220_Tuner::run(ADS1220_Channel channel, float noiseTarget, ADS1220_TuneResult &best,
+                        Stream* table, bool applyBest) {
+    ADS1220_Config saved;
+    _adc.exportConfiguration(saved);
+    uint8_t capacity = _adc.getMovingAverageCapacity();
+    if (capacity < 1) {
+        capacity = 1;  // Sin buffer: las lecturas filtradas no promedian
+    }
+
+    if (table != nullptr) {
+        printHeader(table);
+    }
+
+    bool met = false;
+    best.valid = false;
+
+    for (uint8_t dr = 0; dr < 7; dr++) {
+        if (!(_dataRateMask & (1 << dr))) continue;
+
+        for (uint8_t g = 0; g < 8; g++) {
+            if (!(_gainMask & (1 << g))) continue;
+
+            // El bypass del PGA solo admite ganancias 1, 2 y 4
+            uint8_t variants = (_pgaBypass && g <= 2) ? 2 : 1;
+            for (uint8_t v = 0; v < variants; v++) {
+                ADS1220_TuneResult result;
+                measure(channel, (uint8_t)(dr << 5), (uint8_t)(g << 1), v == 1, result);
+                if (table != nullptr) {
+                    printRow(table, result);
+                }
+                if (!result.valid) continue;
+
+                // Menor promedio de esta combinación que cumple el objetivo
+                for (uint8_t n = 0; n < ADS1220_TUNE_LEVELS; n++) {
+                    uint8_t k = (uint8_t)(1 << n);
+                    if (k > capacity || (_samples >> n) < 2) break;  // τ sin pares medidos
+
+                    ADS1220_TuneResult candidate = result;
+                    candidate.avgSize = k;
+                    candidate.noise = result.allan[n];
+                    candidate.latency_ms = (float)k * result.readTime_ms;
+
+                    if (candidate.noise <= noiseTarget) {
+                        if (!met || candidate.latency_ms < best.latency_ms ||
+                            (candidate.latency_ms == best.latency_ms && candidate.noise < best.noise)) {
+                            best = candidate;
+                        }
+                        met = true;
+                        break;
+                    }
+                    // Sin ninguna que cumpla: la de menor ruido
+                    if (!met && (!best.valid || candidate.noise < best.noise)) {
+                        best = candidate;
+                    }
+                }
+            }
+        }
+    }
+
+    _adc.importConfiguration(saved);
+    if (applyBest && best.valid) {
+        apply(best);
+    }
+    return met;
+}
+
+// =============================================================================
+// TABLA CSV
+// =============================================================================
+
+void ADS1220_Tuner::printHeader(Stream* out) {
+    out->print(F("sps,gain,pga_bypass,rms_uV,enob"));
+    for (uint8_t n = 0; n < ADS1220_TUNE_LEVELS; n++) {
+        out->print(F(",allan_"));
+        out->print(1 << n);
+    }
+    out->println(F(",read_ms,valid"));
+}
+
+void ADS1220_Tuner::printRow(Stream* out, const ADS1220_TuneResult &result) {
+    out->print(s_dataRateSPS[(result.dataRate >> 5) % 7]); out->print(',');
+    out->print(1 << ((result.gain >> 1) & 0x07)); out->print(',');
+    out->print(result.pgaBypass ? 1 : 0); out->print(',');
+    out->print(result.rms_uV, 3); out->print(',');
+    out->print(result.enob, 2);
+    for (uint8_t n = 0; n < ADS1220_TUNE_LEVELS; n++) {
+        out->print(',');
+        out->print(result.allan[n], 6);
+    }
+    out->print(',');
+    out->print(result.readTime_ms, 2); out->print(',');
+    out->println(result.valid ? 1 : 0);
+}
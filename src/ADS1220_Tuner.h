@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * ADS1220_NTC Extended Library - Caracterización de ruido y ajuste automático
+ *
+ * Barre data rate, ganancia y bypass del PGA sobre un canal con el sensor
+ * conectado y, para cada combinación, mide:
+ *   - Ruido RMS de una conversión referido a la entrada [µV]
+ *   - Resolución efectiva (ENOB) = log2(2^24 / σ_código)
+ *   - Desviación de Allan a τ = 1, 2, 4, 8, 16 conversiones (°C o W/m²)
+ *   - Duración real de una lectura (asentamiento + conversión)
+ *
+ * RMS y ENOB salen de la desviación de Allan a τ = 1 (diferencias entre
+ * conversiones sucesivas), que no incluye la deriva lenta del proceso
+ * térmico. La desviación de Allan a τ = k es el ruido que deja un promedio
+ * de k muestras (incluido el ruido 1/f, que un promedio no reduce), así que
+ * de cada combinación se elige el menor promedio móvil que cumple el
+ * objetivo y su latencia es k × duración de la lectura.
+ *
+ * Solo usa la API pública del driver (startRead()/poll()): funciona igual
+ * con ADS1220_SPITransport y con ADS1220_MockTransport en el host. La
+ * Allan se calcula en cascada por octavas, sin guardar las muestras.
+ *
+ * Mientras corre no debe haber otra lectura en curso (ni ADS1220_AsyncESP32
+ * ni ADS1220_BusArbiter atendiendo el driver); las muestras del barrido
+ * pasan por el pipeline normal (buffer, estadísticas, eventos, control).
+ ******************************************************************************/
+
+#ifndef ADS1220_TUNER_H
+#define ADS1220_TUNER_H
+
+#include <Arduino.h>
+#include "ADS1220_NTC_Extended.h"
+
+#define ADS1220_TUNE_SAMPLES    64      // Conversiones medidas por combinación
+#define ADS1220_TUNE_DISCARD    2       // Conversiones descartadas tras cada cambio
+#define ADS1220_TUNE_LEVELS     5       // Allan a τ = 1, 2, 4, 8, 16 conversiones
+
+struct ADS1220_TuneResult {
+    uint8_t dataRate;                   // ADS1220_DR_*
+    uint8_t gain;                       // ADS1220_GAIN_*
+    bool pgaBypass;
+    uint8_t avgSize;                    // Promedio móvil elegido para esta combinación
+    float rms_uV;                       // Ruido de una conversión (referencia interna) [µV]
+    float enob;                         // Resolución efectiva [bits]
+    float allan[ADS1220_TUNE_LEVELS];   // Desviación de Allan (°C o W/m²); 0 = sin datos
+    float readTime_ms;                  // Duración medida de una lectura
+    float noise;                        // allan con avgSize muestras (°C o W/m²)
+    float latency_ms;                   // avgSize × readTime_ms
+    bool valid;                         // false si saturó o no respondió
+};
+
+class ADS1220_Tuner {
+public:
+    /**
+     * @brief Constructor
+     * @param adc Driver ya inicializado con begin()
+     */
+    ADS1220_Tuner(ADS1220_NTC_Extended &adc);
+
+    /**
+     * @brief Combinaciones a barrer
+     * @param dataRateMask Bit n = data rate n (0 = 20 SPS ... 6 = 1000 SPS)
+     * @param gainMask Bit n = ganancia 2^n
+     * @param pgaBypass true para probar también el bypass (ganancias 1, 2 y 4)
+     */
+    void setSweep(uint8_t dataRateMask, uint8_t gainMask, bool pgaBypass = true);
+
+    /**
+     * @brief Conversiones medidas por combinación (mín. 8; 64 o más para τ = 16)
+     */
+    void setSampleCount(uint16_t samples);
+
+    /**
+     * @brief Barre las combinaciones y recomienda la de menor latencia
+     * @param channel Canal a caracterizar (modo y calibración ya configurados)
+     * @param noiseTarget Ruido máximo tras el promedio (°C o W/m²)
+     * @param best Recomendación; si nada cumple, la de menor ruido
+     * @param table Si no es nullptr, recibe la tabla CSV del barrido
+     * @param applyBest true para dejar aplicada la recomendación
+     * @return true si alguna combinación cumple noiseTarget
+     *
+     * Sin applyBest se restaura la configuración previa. Con 64 muestras y el
+     * asentamiento por defecto, cada combinación a 20 SPS tarda unos 4 s.
+     */
+    bool run(ADS1220_Channel channel, float noiseTarget, ADS1220_TuneResult &best,
+             Stream* table = nullptr, bool applyBest = false);
+
+    /**
+     * @brief Aplica data rate, ganancia, bypass y promedio de un resultado
+     */
+    void apply(const ADS1220_TuneResult &result);
+
+    /**
+     * @brief Mide una combinación (sin elegir promedio)
+     * @return result.valid
+     */
+    bool measure(ADS1220_Channel channel, uint8_t dataRate, uint8_t gain, bool pgaBypass,
+                 ADS1220_TuneResult &result);
+
+    /**
+     * @brief Cabecera y fila de la tabla CSV
+     */
+    static void printHeader(Stream* out);
+    static void printRow(Stream* out, const ADS1220_TuneResult &result);
+
+private:
+    ADS1220_NTC_Extended &_adc;
+    uint8_t _dataRateMask;
+    uint8_t _gainMask;
+    bool _pgaBypass;
+    uint16_t _samples;
+
+    bool _read(ADS1220_Channel channel, ADS1220_Sample &sample, uint32_t &duration_us);
+};
+
+#endif // ADS1220_TUNER_H